@@ -1,7 +1,13 @@
 #!/usr/bin/bash
 cd "$(dirname "$0")"
 
-methods=(seqan2 seqan3 io2 ivio)
+methods=(seqan2 seqan3 io2 ivio ivio_decode)
 files=(../data/sampled.bam)
+if [ "$1" == "write" ]; then
+    methods=(seqan2 seqan3 ivio)
+elif [ "$1" == "convert" ]; then
+    methods=(samtools ivio)
+    files=(../data/sampled.sam ../data/sampled.bam)
+fi
 
 source ../utils/benchmark.sh "$@"
@@ -4,3 +4,5 @@ cd "$(dirname "$0")"
 source ../utils/build.sh
 
 build src/read benchmark_read
+build src/write benchmark_write
+build src/convert benchmark_convert
@@ -0,0 +1,9 @@
+#include <ivio/bam/sam_transcoder.h>
+
+void ivio_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr) {
+    if (pathIn.extension() == ".sam") {
+        ivio::bam::samToBam({.input = pathIn}, {.output = pathOut, .threadNbr = threadNbr});
+    } else {
+        ivio::bam::bamToSam({.input = pathIn, .threadNbr = threadNbr}, {.output = pathOut});
+    }
+}
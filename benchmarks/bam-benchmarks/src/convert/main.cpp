@@ -0,0 +1,110 @@
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <vector>
+#include <sys/resource.h>
+#include <ivio/bam/reader.h>
+#include <ivio/sam/reader.h>
+
+void samtools_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr);
+void ivio_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr);
+
+// number of records and number of bases
+static auto summary(std::filesystem::path const& file) -> std::array<size_t, 2> {
+    auto res = std::array<size_t, 2>{};
+    if (file.extension() == ".sam") {
+        for (auto record : ivio::sam::reader{{file}}) {
+            res[0] += 1;
+            res[1] += (record.seq == "*") ? 0 : record.seq.size();
+        }
+    } else {
+        for (auto record : ivio::bam::reader{{file}}) {
+            res[0] += 1;
+            res[1] += record.seq.size;
+        }
+    }
+    return res;
+}
+
+int main(int argc, char** argv) {
+    auto p = [](auto v, size_t w) {
+        auto ss = std::stringstream{};
+        ss << std::boolalpha << v;
+        auto str = ss.str();
+        while (str.size() < w) {
+            str += " ";
+        }
+        return str;
+    };
+
+    try {
+        if (argc < 3) return 0;
+        auto method     = std::string_view{argv[1]};
+        auto input_file = std::filesystem::path{argv[2]};
+        auto threadNbr  = [&]() -> size_t {
+            if (argc > 3) return std::stoull(argv[3]);
+            return 0;
+        }();
+        if (argc > 4) return 0;
+
+        auto output_file = std::filesystem::path{"/tmp/ivio_bench"} / input_file.filename();
+        output_file.replace_extension((input_file.extension() == ".sam") ? ".bam" : ".sam");
+        std::filesystem::create_directories(output_file.parent_path());
+
+        int fastestRun{};
+        auto fastestTime = std::numeric_limits<int>::max();
+        int maxNbrOfRuns{5};
+
+        for (int i{}; i < maxNbrOfRuns; ++i) {
+            auto start  = std::chrono::high_resolution_clock::now();
+
+            if (method == "samtools")  samtools_bench(input_file, output_file, threadNbr);
+            else if (method == "ivio") ivio_bench(input_file, output_file, threadNbr);
+            else throw std::runtime_error("unknown method");
+
+            auto end  = std::chrono::high_resolution_clock::now();
+            auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+            if (diff < fastestTime) {
+                fastestTime = diff;
+                fastestRun = i;
+            }
+        }
+        // check that all records and bases arrived
+        if (summary(input_file) != summary(output_file)) {
+            throw std::runtime_error("incorrect output");
+        }
+
+        // print results
+        [&]() {
+
+            auto timeInMs = fastestTime;
+            size_t a = std::filesystem::file_size(std::string{input_file});
+            auto memory = []() {
+                rusage usage;
+                getrusage(RUSAGE_SELF, &usage);
+                return usage.ru_maxrss / 1024;
+            }();
+            timeInMs = std::max(1, timeInMs);
+            std::cout << "method  \tcorrect \ttotal(MB)\tspeed(MB/s)\tmemory(MB)\n";
+            std::cout << p(method, 8) << "\t"
+                      << p(true, 8) << "\t"
+                      << p(a/1024/1024, 8) << "\t"
+                      << p(a/1024/timeInMs, 8) << "\t"
+                      << p(memory, 8) << "\t"
+                      << (fastestRun+1) << "/" << maxNbrOfRuns << "\n";
+        }();
+
+    } catch (std::exception const& e) {
+        std::cout << "method  \tcorrect \ttotal(MB)\tspeed(MB/s)\tmemory(MB)\n";
+        std::cout << p(std::string{argv[1]}, 8) << "\t"
+                  << p(false, 8) << "\t"
+                  << p(0, 8) << "\t"
+                  << p(0, 8) << "\t"
+                  << p(0, 8) << "\t"
+                  << 0 << "/" << 0 << "\n";
+    }
+}
@@ -0,0 +1,12 @@
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+void samtools_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr) {
+    auto format = (pathIn.extension() == ".sam") ? std::string{" -b"} : std::string{" -h"};
+    auto call = "samtools view -@ " + std::to_string(threadNbr) + format
+              + " -o \"" + pathOut.string() + "\" \"" + pathIn.string() + "\"";
+    if (system(call.c_str())) {
+        throw std::runtime_error("calling samtools failed");
+    }
+}
@@ -0,0 +1,26 @@
+#include "Result.h"
+
+#include <ivio/bam/reader.h>
+
+auto ivio_decode_bench(std::filesystem::path file, size_t threadNbr) -> Result {
+    Result result;
+    std::array<size_t, 16> ctChars{};
+    std::vector<uint8_t> ranks;
+    std::vector<char>    qual;
+    for (auto record : ivio::bam::reader{{file, threadNbr}}) {
+        ranks.resize(record.seq.size);
+        record.seq.decode_ranks_into(ranks);
+        for (auto c : ranks) {
+            ctChars[c] += 1;
+        }
+        qual.resize(record.qual.size());
+        record.decode_qual_into(qual);
+    }
+    result.ctChars[0] = ctChars[ivio::bam::record_view::char_to_rank['A']];
+    result.ctChars[1] = ctChars[ivio::bam::record_view::char_to_rank['C']];
+    result.ctChars[2] = ctChars[ivio::bam::record_view::char_to_rank['G']];
+    result.ctChars[3] = ctChars[ivio::bam::record_view::char_to_rank['T']];
+    result.ctChars[4] = ctChars[ivio::bam::record_view::char_to_rank['N']];
+
+    return result;
+}
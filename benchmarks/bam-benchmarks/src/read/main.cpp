@@ -10,6 +10,7 @@ auto seqan2_bench(std::filesystem::path file, size_t threadNbr) -> Result;
 auto seqan3_bench(std::filesystem::path file, size_t threadNbr) -> Result;
 auto io2_bench(std::filesystem::path file, size_t threadNbr) -> Result;
 auto ivio_bench(std::filesystem::path file, size_t threadNbr) -> Result;
+auto ivio_decode_bench(std::filesystem::path file, size_t threadNbr) -> Result;
 
 int main(int argc, char** argv) {
     try {
@@ -35,6 +36,7 @@ int main(int argc, char** argv) {
                     if (method == "seqan3")           return seqan3_bench(file, threadNbr);
                     if (method == "io2")              return io2_bench(file, threadNbr);
                     if (method == "ivio")             return ivio_bench(file, threadNbr);
+                    if (method == "ivio_decode")      return ivio_decode_bench(file, threadNbr);
                     throw std::runtime_error("unknown method: " + std::string{method});
                 }();
                 auto end  = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct Record {
+    int32_t     refID;
+    int32_t     pos;
+    uint16_t    flag;
+    uint8_t     mapq;
+    std::string name;
+    std::vector<std::tuple<uint32_t, char>> cigar; // length and operation
+    std::string seq;  // IUPAC characters
+    std::string qual; // phred values + 33
+};
+
+struct Data {
+    std::vector<std::string> refNames;
+    std::vector<uint32_t>    refLengths;
+    std::vector<Record>      records;
+};
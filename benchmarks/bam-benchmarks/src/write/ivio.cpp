@@ -0,0 +1,49 @@
+#include "Data.h"
+
+#include <cstring>
+#include <filesystem>
+#include <ivio/bam/writer.h>
+
+void ivio_bench(std::filesystem::path file, Data const& data, size_t threadNbr) {
+    auto header = ivio::bam::header{};
+    for (size_t i{0}; i < data.refNames.size(); ++i) {
+        header.referenceNames.push(data.refNames[i]);
+        header.referenceLengths.push_back(data.refLengths[i]);
+    }
+    auto writer = ivio::bam::writer{{.output    = file,
+                                     .header    = header,
+                                     .threadNbr = threadNbr}};
+
+    std::vector<uint8_t> cigar;
+    std::vector<uint8_t> seq;
+    std::vector<uint8_t> qual;
+    for (auto const& r : data.records) {
+        cigar.resize(r.cigar.size()*4);
+        for (size_t i{0}; i < r.cigar.size(); ++i) {
+            auto [len, op] = r.cigar[i];
+            uint32_t v = (len << 4) | std::string_view{"MIDNSHP=X"}.find(op);
+            std::memcpy(cigar.data() + i*4, &v, 4);
+        }
+        seq.assign((r.seq.size()+1)/2, 0);
+        for (size_t i{0}; i < r.seq.size(); ++i) {
+            seq[i/2] |= ivio::bam::record_view::char_to_rank[r.seq[i]] << ((i%2==0)?4:0);
+        }
+        qual.resize(r.qual.size());
+        for (size_t i{0}; i < r.qual.size(); ++i) {
+            qual[i] = r.qual[i] - 33;
+        }
+        writer.write({.refID      = r.refID,
+                      .pos        = r.pos,
+                      .mapq       = r.mapq,
+                      .bin        = 0,
+                      .flag       = r.flag,
+                      .next_refID = -1,
+                      .next_pos   = -1,
+                      .tlen       = 0,
+                      .read_name  = r.name,
+                      .cigar      = cigar,
+                      .seq        = {seq, r.seq.size()},
+                      .qual       = qual,
+                      .tags       = {}});
+    }
+}
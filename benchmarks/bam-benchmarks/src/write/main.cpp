@@ -0,0 +1,145 @@
+#include "Data.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <vector>
+#include <sys/resource.h>
+#include <ivio/bam/reader.h>
+
+void seqan2_bench(std::filesystem::path file, Data const& data, size_t threadNbr);
+void seqan3_bench(std::filesystem::path file, Data const& data, size_t threadNbr);
+void ivio_bench(std::filesystem::path file, Data const& data, size_t threadNbr);
+
+static auto toRecord(ivio::bam::record_view r) -> Record {
+    auto res = Record{
+        .refID = r.refID,
+        .pos   = r.pos,
+        .flag  = r.flag,
+        .mapq  = r.mapq,
+        .name  = std::string{r.read_name.substr(0, r.read_name.find('\0'))},
+    };
+    for (size_t i{0}; i+4 <= r.cigar.size(); i += 4) {
+        uint32_t v;
+        std::memcpy(&v, r.cigar.data() + i, 4);
+        res.cigar.emplace_back(v >> 4, "MIDNSHP=X"[v & 0xf]);
+    }
+    for (auto c : r.seq) {
+        res.seq += ivio::bam::record_view::rank_to_char[c];
+    }
+    for (auto q : r.qual) {
+        res.qual += char(q + 33);
+    }
+    return res;
+}
+
+static auto loadData(std::filesystem::path const& input_file) -> Data {
+    auto data   = Data{};
+    auto reader = ivio::bam::reader{{input_file}};
+    auto const& header = reader.header();
+    for (size_t i{0}; i < header.referenceNames.size(); ++i) {
+        data.refNames.emplace_back(header.referenceName(i));
+        data.refLengths.emplace_back(header.referenceLength(i));
+    }
+    for (auto record : reader) {
+        data.records.emplace_back(toRecord(record));
+    }
+    return data;
+}
+
+// reads the written file back and compares the fields that all methods write
+static auto verify(std::filesystem::path const& file, Data const& data) -> bool {
+    size_t i{0};
+    for (auto record : ivio::bam::reader{{file}}) {
+        if (i >= data.records.size()) return false;
+        auto r = toRecord(record);
+        auto const& e = data.records[i++];
+        if (r.refID != e.refID or r.pos != e.pos or r.flag != e.flag or r.mapq != e.mapq
+            or r.name != e.name or r.cigar != e.cigar or r.seq != e.seq or r.qual != e.qual) {
+            return false;
+        }
+    }
+    return i == data.records.size();
+}
+
+int main(int argc, char** argv) {
+    auto p = [](auto v, size_t w) {
+        auto ss = std::stringstream{};
+        ss << std::boolalpha << v;
+        auto str = ss.str();
+        while (str.size() < w) {
+            str += " ";
+        }
+        return str;
+    };
+
+    try {
+        if (argc < 3) return 0;
+        auto method     = std::string_view{argv[1]};
+        auto input_file = std::filesystem::path{argv[2]};
+        auto threadNbr = [&]() {
+            if (argc > 3) return std::stoi(argv[3]);
+            return 1;
+        }();
+        if (argc > 4) return 0;
+
+        auto data = loadData(input_file);
+
+        auto file   = std::filesystem::path{"/tmp/ivio_bench"} / input_file.filename();
+        std::filesystem::create_directories(file.parent_path());
+
+        int fastestRun{};
+        auto fastestTime = std::numeric_limits<int>::max();
+        int maxNbrOfRuns{5};
+        for (int i{}; i < maxNbrOfRuns; ++i) {
+            auto start  = std::chrono::high_resolution_clock::now();
+
+            if (method == "seqan2")      seqan2_bench(file, data, threadNbr);
+            else if (method == "seqan3") seqan3_bench(file, data, threadNbr);
+            else if (method == "ivio")   ivio_bench(file, data, threadNbr);
+            else throw std::runtime_error("unknown method");
+
+            auto end  = std::chrono::high_resolution_clock::now();
+            auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+            bool correct = verify(file, data);
+            if (!correct) {
+                throw std::runtime_error("incorrect output");
+            }
+            if (diff < fastestTime and correct) {
+                fastestTime = diff;
+                fastestRun = i;
+            }
+        }
+        // print results
+        [&]() {
+
+            auto timeInMs = fastestTime;
+            size_t a = std::filesystem::file_size(std::string{input_file});
+            auto memory = []() {
+                rusage usage;
+                getrusage(RUSAGE_SELF, &usage);
+                return usage.ru_maxrss / 1024;
+            }();
+            timeInMs = std::max(1, timeInMs);
+            std::cout << "method  \tcorrect \ttotal(MB)\tspeed(MB/s)\tmemory(MB)\n";
+            std::cout << p(method, 8) << "\t"
+                      << p(true, 8) << "\t"
+                      << p(a/1024/1024, 8) << "\t"
+                      << p(a/1024/timeInMs, 8) << "\t"
+                      << p(memory, 8) << "\t"
+                      << (fastestRun+1) << "/" << maxNbrOfRuns << "\n";
+        }();
+
+    } catch (std::exception const& e) {
+        std::cout << "method  \tcorrect \ttotal(MB)\tspeed(MB/s)\tmemory(MB)\n";
+        std::cout << p(std::string{argv[1]}, 8) << "\t"
+                  << p(false, 8) << "\t"
+                  << p(0, 8) << "\t"
+                  << p(0, 8) << "\t"
+                  << p(0, 8) << "\t"
+                  << 0 << "/" << 0 << "\n";
+    }
+}
@@ -0,0 +1,36 @@
+#include "Data.h"
+
+#include <filesystem>
+#include <seqan/bam_io.h>
+
+using namespace seqan;
+
+void seqan2_bench(std::filesystem::path file, Data const& data, size_t threadNbr) {
+    BamFileOut fileOut(file.c_str());
+
+    for (size_t i{0}; i < data.refNames.size(); ++i) {
+        appendValue(contigNames(context(fileOut)), data.refNames[i]);
+        appendValue(contigLengths(context(fileOut)), data.refLengths[i]);
+    }
+    BamHeader header;
+    writeHeader(fileOut, header);
+
+    BamAlignmentRecord record;
+    for (auto const& r : data.records) {
+        record.qName    = r.name;
+        record.flag     = r.flag;
+        record.rID      = r.refID;
+        record.beginPos = r.pos;
+        record.mapQ     = r.mapq;
+        record.rNextId  = BamAlignmentRecord::INVALID_REFID;
+        record.pNext    = BamAlignmentRecord::INVALID_POS;
+        record.tLen     = 0;
+        clear(record.cigar);
+        for (auto [len, op] : r.cigar) {
+            appendValue(record.cigar, CigarElement<>(op, len));
+        }
+        record.seq  = r.seq;
+        record.qual = r.qual;
+        writeRecord(fileOut, record);
+    }
+}
@@ -0,0 +1,45 @@
+#include "Data.h"
+
+#include <seqan3/alphabet/cigar/cigar.hpp>
+#include <seqan3/alphabet/nucleotide/dna5.hpp>
+#include <seqan3/alphabet/quality/phred42.hpp>
+#include <seqan3/io/sam_file/output.hpp>
+#include <filesystem>
+
+void seqan3_bench(std::filesystem::path file, Data const& data, size_t threadNbr) {
+    seqan3::contrib::bgzf_thread_count = threadNbr;
+
+    using types  = seqan3::type_list<std::vector<seqan3::dna5>, std::string, std::optional<int32_t>, std::optional<int32_t>,
+                                     std::vector<seqan3::cigar>, uint8_t, seqan3::sam_flag, std::vector<seqan3::phred42>>;
+    using fields = seqan3::fields<seqan3::field::seq, seqan3::field::id, seqan3::field::ref_id, seqan3::field::ref_offset,
+                                  seqan3::field::cigar, seqan3::field::mapq, seqan3::field::flag, seqan3::field::qual>;
+    using sam_record_type = seqan3::sam_record<types, fields>;
+
+    auto writer = seqan3::sam_file_output{file, data.refNames, data.refLengths, fields{}};
+
+    for (auto const& r : data.records) {
+        auto record = sam_record_type{};
+        auto& seq = record.sequence();
+        seq.resize(r.seq.size());
+        for (size_t i{0}; i < r.seq.size(); ++i) {
+            seqan3::assign_char_to(r.seq[i], seq[i]);
+        }
+        record.id() = r.name;
+        if (r.refID >= 0) record.reference_id() = r.refID;
+        if (r.pos >= 0)   record.reference_position() = r.pos;
+        for (auto [len, op] : r.cigar) {
+            auto c = seqan3::cigar{};
+            c = len;
+            c = seqan3::cigar::operation{}.assign_char(op);
+            record.cigar_sequence().push_back(c);
+        }
+        record.mapping_quality() = r.mapq;
+        record.flag() = seqan3::sam_flag{r.flag};
+        auto& qual = record.base_qualities();
+        qual.resize(r.qual.size());
+        for (size_t i{0}; i < r.qual.size(); ++i) {
+            seqan3::assign_char_to(r.qual[i], qual[i]);
+        }
+        writer.push_back(record);
+    }
+}
@@ -1,7 +1,7 @@
 #!/usr/bin/bash
 cd "$(dirname "$0")"
 
-methods=(bio ivio)
+methods=(bio ivio ivio_vcf)
 files=(../data/sampled.bcf)
 
 source ../utils/benchmark.sh "$@"
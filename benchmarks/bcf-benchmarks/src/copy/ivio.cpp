@@ -4,8 +4,9 @@
 void ivio_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr) {
     auto reader = ivio::bcf::reader{{.input     = pathIn,
                                      .threadNbr = threadNbr}};
-    auto writer = ivio::bcf::writer{{.output = pathOut,
-                                     .header = reader.header() }};
+    auto writer = ivio::bcf::writer{{.output    = pathOut,
+                                     .header    = reader.header(),
+                                     .threadNbr = threadNbr }};
 
     for (auto record_view : reader) {
         writer.write(record_view);
@@ -0,0 +1,5 @@
+#include <ivio/bcf/vcf_transcoder.h>
+
+void ivio_vcf_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr) {
+    ivio::bcf::bcfToVcf({.input = pathIn}, {.output = pathOut.replace_extension(".vcf")}, threadNbr);
+}
@@ -10,6 +10,7 @@
 void seqan2_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr);
 void bio_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr);
 void ivio_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr);
+void ivio_vcf_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr);
 
 int main(int argc, char** argv) {
     auto p = [](auto v, size_t w) {
@@ -45,6 +46,7 @@ int main(int argc, char** argv) {
             if (method == "seqan2")      seqan2_bench(input_file, output_file, threadNbr);
             else if (method == "bio")    bio_bench(input_file, output_file, threadNbr);
             else if (method == "ivio")   ivio_bench(input_file, output_file, threadNbr);
+            else if (method == "ivio_vcf") ivio_vcf_bench(input_file, output_file, threadNbr);
             else throw std::runtime_error("unknown method");
 
             auto end  = std::chrono::high_resolution_clock::now();
@@ -55,8 +57,8 @@ int main(int argc, char** argv) {
                 fastestRun = i;
             }
         }
-        // check correctness of file (doesn't work for bio since it reorders the header)
-        if (method != "bio") {
+        // check correctness of file (doesn't work for bio since it reorders the header, ivio_vcf writes a vcf file)
+        if (method != "bio" and method != "ivio_vcf") {
             int result = system(("test $(sha256sum -b " + input_file.string() + " | cut -f 1 -d ' ')"
                              " ==  $(sha256sum -b " + output_file.string() + " | cut -f 1 -d ' ')").c_str());
             if (result) {
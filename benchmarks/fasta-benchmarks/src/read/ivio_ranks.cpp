@@ -0,0 +1,15 @@
+#include "Result.h"
+
+#include <ivio/fasta/reader.h>
+
+auto ivio_ranks_bench(std::filesystem::path file) -> Result {
+    Result result;
+
+    auto reader = ivio::fasta::reader{{.input = file, .encoding = ivio::seq_encoding::dna5_ranks}};
+    for (auto && [id, seq] : reader) {
+        for (auto c : seq) {
+            result.ctChars[c] += 1;
+        }
+    }
+    return result;
+}
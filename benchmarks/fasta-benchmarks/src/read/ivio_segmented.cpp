@@ -0,0 +1,18 @@
+#include "Result.h"
+#include "dna5_rank_view.h"
+
+#include <ivio/fasta/reader.h>
+
+auto ivio_segmented_bench(std::filesystem::path file) -> Result {
+    Result result;
+
+    auto reader = ivio::fasta::reader{{.input = file}};
+    while (auto r = reader.nextSegmented()) {
+        for (auto line : r->seq.lines) {
+            for (auto c : line | dna5_rank_view) {
+                result.ctChars[c] += 1;
+            }
+        }
+    }
+    return result;
+}
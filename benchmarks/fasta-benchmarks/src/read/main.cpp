@@ -12,6 +12,8 @@ auto io2_bench(std::filesystem::path file) -> Result;
 auto bio_bench(std::filesystem::path file) -> Result;
 auto ivio_bench(std::filesystem::path file) -> Result;
 auto ivio_mt_bench(std::filesystem::path file) -> Result;
+auto ivio_segmented_bench(std::filesystem::path file) -> Result;
+auto ivio_ranks_bench(std::filesystem::path file) -> Result;
 auto direct_bench(std::filesystem::path path) -> Result;
 auto extreme_bench(std::filesystem::path path) -> Result;
 
@@ -47,6 +49,8 @@ int main(int argc, char** argv) {
                 if (method == "bio")              return bio_bench(file);
                 if (method == "ivio_mt")          return ivio_mt_bench(file);
                 if (method == "ivio")             return ivio_bench(file);
+                if (method == "ivio_segmented")   return ivio_segmented_bench(file);
+                if (method == "ivio_ranks")       return ivio_ranks_bench(file);
                 if (method == "direct")           return direct_bench(file);
                 if (method == "extreme")          return extreme_bench(file);
                 throw std::runtime_error("unknown method: " + std::string{method});
@@ -1,7 +1,7 @@
 #!/usr/bin/bash
 cd "$(dirname "$0")"
 
-methods=(seqan2 bio ivio)
+methods=(seqan2 bio ivio ivio_bcf)
 files=(../data/sampled.vcf)
 
 source ../utils/benchmark.sh
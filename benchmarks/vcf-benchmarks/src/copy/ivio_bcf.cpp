@@ -0,0 +1,5 @@
+#include <ivio/bcf/vcf_transcoder.h>
+
+void ivio_bcf_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr) {
+    ivio::bcf::vcfToBcf({.input = pathIn}, {.output = pathOut.replace_extension(".bcf"), .threadNbr = threadNbr}, threadNbr);
+}
@@ -11,6 +11,7 @@
 void seqan2_bench(std::filesystem::path pathIn, std::filesystem::path pathOut);
 void bio_bench(std::filesystem::path pathIn, std::filesystem::path pathOut);
 void ivio_bench(std::filesystem::path pathIn, std::filesystem::path pathOut);
+void ivio_bcf_bench(std::filesystem::path pathIn, std::filesystem::path pathOut, size_t threadNbr);
 
 int main(int argc, char** argv) {
     auto p = [](auto v, size_t w) {
@@ -24,9 +25,13 @@ int main(int argc, char** argv) {
     };
 
     try {
-        if (argc != 3) return 0;
+        if (argc < 3 or argc > 4) return 0;
         auto method     = std::string_view{argv[1]};
         auto input_file = std::filesystem::path{argv[2]};
+        auto threadNbr  = [&]() -> size_t {
+            if (argc > 3) return std::stoull(argv[3]);
+            return 0;
+        }();
 
         bool compressed = (input_file.extension() == ".gz");
 
@@ -42,6 +47,7 @@ int main(int argc, char** argv) {
             if (method == "seqan2")      seqan2_bench(input_file, output_file);
             else if (method == "bio")    bio_bench(input_file, output_file);
             else if (method == "ivio")   ivio_bench(input_file, output_file);
+            else if (method == "ivio_bcf") ivio_bcf_bench(input_file, output_file, threadNbr);
             else throw std::runtime_error("unknown method");
 
             auto end  = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace ivio {
+
+/*!\brief Encoding of sequences returned by the fasta and fastq readers
+ *
+ * chars:      sequence as it appears in the file
+ * dna4_ranks: A=0, C=1, G=2, T=3, any other character is mapped to 0
+ * dna5_ranks: A=0, C=1, G=2, T=3, any other character is mapped to N=4
+ *
+ * Lower case characters are treated like upper case characters.
+ */
+enum class seq_encoding {
+    chars,
+    dna4_ranks,
+    dna5_ranks,
+};
+
+namespace alphabet {
+
+constexpr auto is_acgt(char c) -> uint8_t {
+    // summing up single byte comparisons keeps the loops vectorizable
+    auto l = uint8_t(c | 0x20);
+    return uint8_t(uint8_t(l == 'a') + uint8_t(l == 'c') + uint8_t(l == 'g') + uint8_t(l == 't'));
+}
+
+/*!\brief rank of A, C, G and T (upper or lower case), any other character is mapped to 0
+ *
+ * Computed arithmetically instead of via a lookup table, which allows the compiler to
+ * vectorize the loops below.
+ */
+constexpr auto dna4_rank(char c) -> uint8_t {
+    auto v = uint8_t(c);
+    return uint8_t((((v >> 1) ^ (v >> 2)) & 3) * is_acgt(c));
+}
+
+constexpr auto dna5_rank(char c) -> uint8_t {
+    return is_acgt(c) ? dna4_rank(c) : uint8_t{4};
+}
+
+static_assert(dna4_rank('A') == 0 and dna4_rank('C') == 1 and dna4_rank('G') == 2 and dna4_rank('T') == 3);
+static_assert(dna4_rank('a') == 0 and dna4_rank('c') == 1 and dna4_rank('g') == 2 and dna4_rank('t') == 3);
+static_assert(dna4_rank('N') == 0 and dna5_rank('N') == 4 and dna5_rank('n') == 4);
+static_assert(dna4_rank('R') == 0 and dna4_rank('Y') == 0 and dna4_rank('-') == 0 and dna5_rank('Y') == 4);
+
+/*!\brief converts in into ranks, out must have space for in.size() elements
+ */
+inline void to_ranks(seq_encoding encoding, std::string_view in, char* out) {
+    auto ptr = in.data();
+    auto n   = in.size();
+    if (encoding == seq_encoding::dna4_ranks) {
+        for (size_t i{0}; i < n; ++i) {
+            out[i] = dna4_rank(ptr[i]);
+        }
+    } else if (encoding == seq_encoding::dna5_ranks) {
+        for (size_t i{0}; i < n; ++i) {
+            out[i] = dna5_rank(ptr[i]);
+        }
+    } else {
+        for (size_t i{0}; i < n; ++i) {
+            out[i] = ptr[i];
+        }
+    }
+}
+
+/*!\brief packs in as dna4 ranks with 2 bits per base, starting at base position offset
+ *
+ * Characters other than A, C, G and T are packed as A (rank 0).
+ * Base i is stored in word i/32 at bit 2*(i%32). The words must be zero initialized,
+ * out must have space for (offset + in.size() + 31) / 32 words. Calling this once per
+ * line packs a multi-line sequence without concatenating it first.
+ */
+inline void pack_dna4(std::string_view in, std::span<uint64_t> out, size_t offset = 0) {
+    auto ptr = in.data();
+    auto n   = in.size();
+    size_t i{0};
+
+    // unaligned start
+    for (; i < n and (offset + i) % 32 != 0; ++i) {
+        out[(offset + i) / 32] |= uint64_t{dna4_rank(ptr[i])} << (2 * ((offset + i) % 32));
+    }
+    // full words
+    for (; i + 32 <= n; i += 32) {
+        uint64_t w{};
+        for (size_t j{0}; j < 32; ++j) {
+            w |= uint64_t{dna4_rank(ptr[i+j])} << (2*j);
+        }
+        out[(offset + i) / 32] = w;
+    }
+    // tail
+    for (; i < n; ++i) {
+        out[(offset + i) / 32] |= uint64_t{dna4_rank(ptr[i])} << (2 * ((offset + i) % 32));
+    }
+}
+
+}
+}
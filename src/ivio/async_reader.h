@@ -0,0 +1,118 @@
+#pragma once
+
+#include "concepts.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace ivio {
+
+/*!\brief Readable that reads ahead on a separate thread
+ *
+ * Useful to move decompression off the calling thread. At most chunkNbr chunks
+ * of chunkSize bytes are read ahead.
+ */
+template <Readable Reader>
+struct async_reader {
+    struct Chunk {
+        std::vector<char> data;
+        size_t            size{};
+    };
+
+    // State shared with the reading thread, stays in place when the reader is moved
+    struct State {
+        std::mutex              mutex;
+        std::condition_variable cv;
+        std::deque<Chunk>       filled;
+        std::vector<Chunk>      unused;
+        bool                    eof{};
+        bool                    terminate{};
+        std::exception_ptr      error{};
+    };
+
+    std::unique_ptr<State> state{std::make_unique<State>()};
+    std::jthread           thread;
+
+    Chunk  current{};
+    size_t currentPos{};
+
+    async_reader(Reader&& reader, size_t chunkSize = 1<<18, size_t chunkNbr = 4) {
+        for (size_t i{0}; i < chunkNbr; ++i) {
+            state->unused.push_back({std::vector<char>(chunkSize), 0});
+        }
+        thread = std::jthread{[s = state.get(), reader = std::move(reader)]() mutable {
+            auto g = std::unique_lock{s->mutex};
+            while (true) {
+                s->cv.wait(g, [&]() { return s->terminate or !s->unused.empty(); });
+                if (s->terminate) return;
+                auto chunk = std::move(s->unused.back());
+                s->unused.pop_back();
+                g.unlock();
+
+                try {
+                    chunk.size = reader.read(std::span{chunk.data});
+                } catch(...) {
+                    g.lock();
+                    s->error = std::current_exception();
+                    s->eof   = true;
+                    s->cv.notify_all();
+                    return;
+                }
+
+                g.lock();
+                if (chunk.size == 0) {
+                    s->eof = true;
+                    s->cv.notify_all();
+                    return;
+                }
+                s->filled.emplace_back(std::move(chunk));
+                s->cv.notify_all();
+            }
+        }};
+    }
+
+    async_reader(async_reader&&) = default;
+
+    ~async_reader() {
+        if (!state) return;
+        {
+            auto g = std::unique_lock{state->mutex};
+            state->terminate = true;
+        }
+        state->cv.notify_all();
+    }
+
+    size_t read(std::span<char> range) {
+        if (currentPos == current.size) {
+            auto& s = *state;
+            auto g = std::unique_lock{s.mutex};
+            if (!current.data.empty()) {
+                s.unused.emplace_back(std::move(current));
+                s.cv.notify_all();
+            }
+            s.cv.wait(g, [&]() { return s.eof or !s.filled.empty(); });
+            if (s.filled.empty()) {
+                if (s.error) std::rethrow_exception(s.error);
+                current = {};
+                currentPos = 0;
+                return 0;
+            }
+            current = std::move(s.filled.front());
+            s.filled.pop_front();
+            currentPos = 0;
+        }
+        auto size = std::min(range.size(), current.size - currentPos);
+        std::memcpy(range.data(), current.data.data() + currentPos, size);
+        currentPos += size;
+        return size;
+    }
+};
+
+}
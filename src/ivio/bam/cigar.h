@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace ivio::bam {
+
+/*!\brief A single cigar operation
+ *
+ * op is the index into op_chars, as encoded in bam files.
+ */
+struct cigar_op {
+    constexpr static auto op_chars = std::string_view{"MIDNSHP=X"};
+
+    // operations consuming the reference (M, D, N, = and X) and the query (M, I, S, = and X)
+    constexpr static uint32_t reference_mask = (1 << 0) | (1 << 2) | (1 << 3) | (1 << 7) | (1 << 8);
+    constexpr static uint32_t query_mask     = (1 << 0) | (1 << 1) | (1 << 4) | (1 << 7) | (1 << 8);
+
+    uint8_t  op;
+    uint32_t len;
+
+    static auto fromRaw(uint32_t v) -> cigar_op {
+        return {uint8_t(v & 0xf), v >> 4};
+    }
+    auto raw() const -> uint32_t {
+        return (len << 4) | op;
+    }
+
+    auto opChar() const -> char {
+        return op < op_chars.size() ? op_chars[op] : '?';
+    }
+    auto consumesReference() const -> bool {
+        return (reference_mask >> op) & 1;
+    }
+    auto consumesQuery() const -> bool {
+        return (query_mask >> op) & 1;
+    }
+};
+
+/*!\brief Typed view over the binary cigar of a bam record
+ */
+struct cigar_view {
+    std::span<uint8_t const> data;
+
+    auto size() const -> size_t {
+        return data.size() / 4;
+    }
+
+    auto rawAt(size_t i) const -> uint32_t {
+        uint32_t v;
+        std::memcpy(&v, data.data() + i*4, sizeof(v)); // bam is little endian, as are all supported platforms
+        return v;
+    }
+
+    auto operator[](size_t i) const -> cigar_op {
+        return cigar_op::fromRaw(rawAt(i));
+    }
+
+    struct iter {
+        using value_type      = cigar_op;
+        using difference_type = std::ptrdiff_t;
+
+        cigar_view const* view{};
+        size_t            i{};
+
+        auto operator*() const -> cigar_op {
+            return (*view)[i];
+        }
+        auto operator++() -> iter& {
+            ++i;
+            return *this;
+        }
+        auto operator++(int) -> iter {
+            auto r = *this;
+            ++*this;
+            return r;
+        }
+        auto operator==(iter const& _other) const -> bool {
+            return i == _other.i;
+        }
+    };
+
+    auto begin() const -> iter {
+        return {this, 0};
+    }
+    auto end() const -> iter {
+        return {this, size()};
+    }
+
+    /*!\brief sum of the lengths of all operations whose bit is set in mask
+     *
+     * Branch free, so the compiler can vectorize it.
+     */
+    auto sumLengths(uint32_t mask) const -> int64_t {
+        int64_t len{};
+        auto n = size();
+        for (size_t i{0}; i < n; ++i) {
+            auto v = rawAt(i);
+            len += int64_t{v >> 4} * ((mask >> (v & 0xf)) & 1);
+        }
+        return len;
+    }
+
+    // number of reference bases covered by the alignment
+    auto referenceLength() const -> int64_t {
+        return sumLengths(cigar_op::reference_mask);
+    }
+
+    // number of bases of the read, including soft clipped bases
+    auto queryLength() const -> int64_t {
+        return sumLengths(cigar_op::query_mask);
+    }
+
+    /*!\brief number of bases clipped with operation op (S or H) at the front and at the back
+     *
+     * Soft clips are only counted after hard clips, as required by the SAM specification.
+     */
+    auto clipped(char op) const -> std::tuple<uint32_t, uint32_t> {
+        auto n = size();
+        auto isOp   = [&](size_t i) { return (*this)[i].opChar() == op; };
+        auto isHard = [&](size_t i) { return (*this)[i].opChar() == 'H'; };
+
+        uint32_t front{}, back{};
+        size_t i{0};
+        if (op == 'S' and i < n and isHard(i)) ++i;
+        if (i < n and isOp(i)) {
+            front = (*this)[i].len;
+            ++i;
+        }
+        size_t j{n};
+        if (op == 'S' and j > i and isHard(j-1)) --j;
+        if (j > i and isOp(j-1)) {
+            back = (*this)[j-1].len;
+        }
+        return {front, back};
+    }
+
+    auto softClipped() const -> std::tuple<uint32_t, uint32_t> {
+        return clipped('S');
+    }
+    auto hardClipped() const -> std::tuple<uint32_t, uint32_t> {
+        return clipped('H');
+    }
+};
+
+/*!\brief parses a cigar string as written in SAM files into the bam encoding
+ *
+ * "*" results in an empty cigar.
+ */
+inline void parseCigar(std::string_view cigar, std::vector<uint8_t>& out) {
+    out.clear();
+    if (cigar == "*") return;
+    out.reserve(cigar.size() * 2);
+
+    auto invalid = [&]() {
+        return std::runtime_error{"SAM error: invalid cigar " + std::string{cigar}};
+    };
+
+    uint64_t len{};
+    bool     hasDigits{};
+    for (auto c : cigar) {
+        if (c >= '0' and c <= '9') {
+            len = len * 10 + (c - '0');
+            if (len > (uint32_t{1} << 28) - 1) throw invalid();
+            hasDigits = true;
+            continue;
+        }
+        auto op = cigar_op::op_chars.find(c);
+        if (op == std::string_view::npos or !hasDigits) throw invalid();
+
+        auto v = cigar_op{uint8_t(op), uint32_t(len)}.raw();
+        auto oldSize = out.size();
+        out.resize(oldSize + sizeof(v));
+        std::memcpy(out.data() + oldSize, &v, sizeof(v));
+        len       = 0;
+        hasDigits = false;
+    }
+    if (hasDigits) throw invalid();
+}
+
+}
@@ -1,13 +1,42 @@
 #pragma once
 
-#include <vector>
+#include "../string_dictionary.h"
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace ivio::bam {
 
 struct header {
     std::string buffer;
-//    std::vector<std::tuple<std::string, std::string>> table;
+
+    // References as listed in the binary header, indexed by refID
+    string_dictionary     referenceNames;
+    std::vector<uint32_t> referenceLengths;
+
+    // throws for unknown ids, e.g. refID -1 of unmapped reads
+    auto referenceName(int32_t refID) const -> std::string_view {
+        if (refID < 0 or size_t(refID) >= referenceNames.size()) {
+            throw std::runtime_error{"BAM error: unknown reference id " + std::to_string(refID)};
+        }
+        return referenceNames[refID];
+    }
+
+    auto referenceLength(int32_t refID) const -> uint32_t {
+        if (refID < 0 or size_t(refID) >= referenceLengths.size()) {
+            throw std::runtime_error{"BAM error: unknown reference id " + std::to_string(refID)};
+        }
+        return referenceLengths[refID];
+    }
+
+    auto referenceId(std::string_view name) const -> std::optional<int32_t> {
+        if (auto id = referenceNames.find(name)) return *id;
+        return std::nullopt;
+    }
 };
 
 }
@@ -25,20 +25,20 @@ struct reader_base<bam::reader>::pimpl {
 
     bam::header header;
 
-    pimpl(std::filesystem::path file, size_t threadNbr)
+    pimpl(std::filesystem::path file, size_t threadNbr, std::shared_ptr<bgzf_block_cache> cache)
         : ureader {[&]() -> VarBufferedReader {
             if (threadNbr == 0) {
-                return buffered_reader<1<<16>{bgzf_reader{mmap_reader{file}}};
+                return buffered_reader<1<<16>{bgzf_reader{mmap_reader{file}, cache}};
             }
-            return bgzf_mt_reader{mmap_reader{file}, threadNbr};
+            return bgzf_mt_reader{mmap_reader{file}, threadNbr, cache};
         }()}
     {}
-    pimpl(std::istream& file, size_t threadNbr)
+    pimpl(std::istream& file, size_t threadNbr, std::shared_ptr<bgzf_block_cache> cache)
         : ureader {[&]() -> VarBufferedReader {
             if (threadNbr == 0) {
-                return buffered_reader<1<<16>{bgzf_reader{stream_reader{file}}};
+                return buffered_reader<1<<16>{bgzf_reader{stream_reader{file}, cache}};
             }
-            return bgzf_mt_reader{stream_reader{file}, threadNbr};
+            return bgzf_mt_reader{stream_reader{file}, threadNbr, cache};
         }()}
     {}
 
@@ -52,29 +52,32 @@ struct reader_base<bam::reader>::pimpl {
         if (size < 12 + l_text + 8) throw std::runtime_error{"couldn't read header of bam file (1a)"};
 
         header.buffer.resize(l_text);
-        memcpy(header.buffer.data(), ptr + 12, l_text);
+        memcpy(header.buffer.data(), ptr + 8, l_text);
 
         auto n_ref = ivio::bgzfUnpack<uint32_t>(ptr + 8 + l_text);
         ureader.dropUntil(12 + l_text);
 
         // read list of references
+        header.referenceNames.reserve(n_ref);
+        header.referenceLengths.reserve(n_ref);
         for (size_t i{0}; i < n_ref; ++i) {
             std::tie(ptr, size) = ureader.read(9);
             if (size < 9) throw std::runtime_error{"something went wrong reading bam file (1b)"};
             auto l_name = ivio::bgzfUnpack<uint32_t>(ptr);
             std::tie(ptr, size) = ureader.read(8 + l_name);
-            if (size < 8 + l_name) throw std::runtime_error{"error reading entry " + std::to_string(i)};
+            if (size < 8 + l_name or l_name == 0) throw std::runtime_error{"error reading entry " + std::to_string(i)};
             auto l_ref  = ivio::bgzfUnpack<uint32_t>(ptr+4+l_name);
-            //!TODO read name and save it somewhere
+            header.referenceNames.push(std::string_view{ptr+4, l_name-1}); // drop trailing '\0'
+            header.referenceLengths.push_back(l_ref);
             ureader.dropUntil(8+l_name);
         }
     }
 
     auto next() -> std::optional<bam::record_view> {
         ureader.dropUntil(lastUsed);
-        auto [ptr, size] = ureader.read(40);
+        auto [ptr, size] = ureader.read(36); // block_size and all fixed length fields
         if (size == 0) return std::nullopt;
-        if (size < 40) throw std::runtime_error{"something went wrong reading bam file (2)"};
+        if (size < 36) throw std::runtime_error{"something went wrong reading bam file (2)"};
 
         auto block_size  = ivio::bgzfUnpack<uint32_t>(ptr+0);
 
@@ -97,7 +100,8 @@ struct reader_base<bam::reader>::pimpl {
         auto seq         = ureader.string_view(start_seq, start_seq + (l_seq+1)/2);
         auto start_qual  = start_seq + (l_seq+1)/2;
         auto qual        = ureader.string_view(start_qual, start_qual + l_seq);
-        //!TODO List of auxiliary data (tags) is missing
+        auto start_tags  = start_qual + l_seq;
+        auto tags        = ureader.string_view(start_tags, block_size+4);
 
         lastUsed = block_size+4;
 
@@ -113,6 +117,8 @@ struct reader_base<bam::reader>::pimpl {
                                   .cigar      = std::span{reinterpret_cast<uint8_t const*>(cigar.data()), cigar.size()},
                                   .seq        = {std::span{reinterpret_cast<uint8_t const*>(seq.data()), seq.size()}, l_seq},
                                   .qual       = std::span{reinterpret_cast<uint8_t const*>(qual.data()), qual.size()},
+                                  .tags       = std::span{reinterpret_cast<uint8_t const*>(tags.data()), tags.size()},
+                                  .raw        = std::span{reinterpret_cast<uint8_t const*>(ptr2), block_size+4},
                                 };
     }
 };
@@ -122,7 +128,7 @@ namespace ivio::bam {
 
 reader::reader(config const& config_)
     : reader_base{std::visit([&](auto& p) {
-        return std::make_unique<pimpl>(p, config_.threadNbr);
+        return std::make_unique<pimpl>(p, config_.threadNbr, config_.cache);
     }, config_.input)}
 {
     pimpl_->readHeader();
@@ -140,6 +146,17 @@ void reader::close() {
     pimpl_.reset();
 }
 
+auto reader::tell() -> uint64_t {
+    assert(pimpl_);
+    return pimpl_->ureader.tell(pimpl_->lastUsed);
+}
+
+void reader::seek(uint64_t voffset) {
+    assert(pimpl_);
+    pimpl_->ureader.seek(voffset);
+    pimpl_->lastUsed = 0;
+}
+
 static_assert(record_reader_c<reader>);
 
 }
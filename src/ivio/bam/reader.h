@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../bgzf_block_cache.h"
 #include "../reader_base.h"
 #include "header.h"
 #include "record.h"
@@ -24,6 +25,9 @@ struct reader : public reader_base<reader> {
         std::variant<std::filesystem::path, std::reference_wrapper<std::istream>> input;
 
         size_t threadNbr = 0;
+
+        // Optional cache of decompressed blocks, can be shared between readers of the same file
+        std::shared_ptr<bgzf_block_cache> cache{};
     };
 
 public:
@@ -33,6 +37,15 @@ public:
     auto header() const -> bam::header const& { return header_; }
     auto next() -> std::optional<record_view>;
     void close();
+
+    /*!\brief virtual offset of the next record
+     * \returns compressed block offset << 16 | offset inside the uncompressed block
+     */
+    auto tell() -> uint64_t;
+
+    /*!\brief continue reading at a virtual offset previously returned by tell() or from an index
+     */
+    void seek(uint64_t voffset);
 };
 
 }
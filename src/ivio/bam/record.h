@@ -1,6 +1,11 @@
 #pragma once
 
+#include "cigar.h"
+#include "tags.h"
+
+#include <array>
 #include <cstddef>
+#include <cstring>
 #include <optional>
 #include <ranges>
 #include <span>
@@ -20,6 +25,15 @@ struct record_view {
         return r;
     }();
 
+    // two characters for each byte of the compressed sequence
+    constexpr static auto byte_to_chars = []() {
+        auto r = std::array<std::array<char, 2>, 256>{};
+        for (size_t i{0}; i < r.size(); ++i) {
+            r[i] = {rank_to_char[i >> 4], rank_to_char[i & 0xf]};
+        }
+        return r;
+    }();
+
     struct compact_seq {
         std::span<uint8_t const> data; // Data compressed as described in bam
         size_t                   size; // Number of elements stored in the sequence
@@ -31,6 +45,37 @@ struct record_view {
             return c & 0xf;
         }
 
+        /*!\brief decodes all ranks at once, out must have space for size elements
+         *
+         * Much faster than iterating, since the loop can be vectorized.
+         */
+        void decode_ranks_into(std::span<uint8_t> out) const {
+            auto ptr = data.data();
+            auto dst = out.data();
+            for (size_t i{0}; i < size/2; ++i) {
+                dst[i*2]   = ptr[i] >> 4;
+                dst[i*2+1] = ptr[i] & 0xf;
+            }
+            if (size % 2 == 1) {
+                dst[size-1] = ptr[size/2] >> 4;
+            }
+        }
+
+        /*!\brief decodes all characters at once, out must have space for size elements
+         *
+         * Each byte is converted into two characters with a single table lookup.
+         */
+        void decode_into(std::span<char> out) const {
+            auto ptr = data.data();
+            auto dst = out.data();
+            for (size_t i{0}; i < size/2; ++i) {
+                std::memcpy(dst + i*2, byte_to_chars[ptr[i]].data(), 2);
+            }
+            if (size % 2 == 1) {
+                dst[size-1] = byte_to_chars[ptr[size/2]][0];
+            }
+        }
+
         struct iter {
             using value_type = uint8_t;
             compact_seq const* seq;
@@ -63,6 +108,38 @@ struct record_view {
     std::span<uint8_t const>    cigar;
     compact_seq                 seq;
     std::span<uint8_t const>    qual;
+    std::span<uint8_t const>    tags; // raw auxiliary data
+
+    // Complete encoded record including block_size, as read from the file.
+    // Not used by bam::writer::write, pass it to bam::writer::writeRaw to copy the record verbatim.
+    std::span<uint8_t const>    raw{};
+
+    /*!\brief converts the qualities into phred+33 characters, out must have space for qual.size() elements
+     *
+     * Missing qualities (0xff) are not treated specially.
+     */
+    void decode_qual_into(std::span<char> out) const {
+        auto ptr = qual.data();
+        auto dst = out.data();
+        for (size_t i{0}; i < qual.size(); ++i) {
+            dst[i] = char(ptr[i] + 33);
+        }
+    }
+
+    // Typed access to the cigar operations
+    auto cigarView() const -> cigar_view {
+        return {cigar};
+    }
+
+    // Lazy iteration over the auxiliary data
+    auto tagRange() const -> tag_range {
+        return {tags};
+    }
+
+    // Searches for a single tag, e.g. findTag("NM")
+    auto findTag(std::string_view key) const -> std::optional<tag> {
+        return tag_range{tags}.find(key);
+    }
 };
 
 struct record {
@@ -79,6 +156,7 @@ struct record {
     std::vector<uint8_t>        seq;
     size_t                      seq_len;
     std::vector<uint8_t>        qual;
+    std::vector<uint8_t>        tags;
 
     record() = default;
     record(record_view v)
@@ -95,6 +173,7 @@ struct record {
         , seq        {begin(v.seq.data), end(v.seq.data)}
         , seq_len    {v.seq.size}
         , qual       {begin(v.qual), end(v.qual)}
+        , tags       {begin(v.tags), end(v.tags)}
     {}
     operator record_view() const {
         return record_view {
@@ -110,6 +189,7 @@ struct record {
             cigar,
             {seq, seq_len},
             qual,
+            tags,
         };
     }
 };
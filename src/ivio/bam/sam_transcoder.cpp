@@ -0,0 +1,296 @@
+#include "sam_transcoder.h"
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+template <typename T>
+void append(std::vector<uint8_t>& buffer, T v) {
+    auto oldSize = buffer.size();
+    buffer.resize(oldSize + sizeof(T));
+    std::memcpy(buffer.data() + oldSize, &v, sizeof(T)); // bam is little endian, as are all supported platforms
+}
+
+template <typename T>
+auto parse(std::string_view view) -> T {
+    T value{};
+    auto [ptr, ec] = std::from_chars(view.data(), view.data() + view.size(), value);
+    if (ec != std::errc{} or ptr != view.data() + view.size()) {
+        throw std::runtime_error{"SAM error: can't convert \"" + std::string{view} + "\""};
+    }
+    return value;
+}
+
+template <typename T>
+void appendNumber(std::string& buffer, T v) {
+    auto oldSize = buffer.size();
+    buffer.resize(oldSize + 32);
+    auto [ptr, ec] = std::to_chars(buffer.data() + oldSize, buffer.data() + buffer.size(), v);
+    buffer.resize(ptr - buffer.data());
+}
+
+void encodeSeq(std::string_view seq, std::vector<uint8_t>& out) {
+    out.assign((seq.size()+1)/2, 0);
+    for (size_t i{0}; i < seq.size(); ++i) {
+        auto c = seq[i];
+        if (c >= 'a' and c <= 'z') c = c - 'a' + 'A';
+        out[i/2] |= ivio::bam::record_view::char_to_rank[uint8_t(c)] << ((i%2 == 0)?4:0);
+    }
+}
+
+void encodeTag(ivio::sam::tag const& t, std::vector<uint8_t>& out) {
+    out.push_back(t.key[0]);
+    out.push_back(t.key[1]);
+    switch (t.type) {
+        case 'A':
+            if (t.value.size() != 1) throw std::runtime_error{"SAM error: invalid character tag"};
+            out.push_back('A');
+            out.push_back(t.value[0]);
+            return;
+        case 'i': {
+            // smallest type that can hold the value
+            auto v = parse<int64_t>(t.value);
+            if (v < 0) {
+                if (v >= INT8_MIN)       { out.push_back('c'); append<int8_t>(out, v); }
+                else if (v >= INT16_MIN) { out.push_back('s'); append<int16_t>(out, v); }
+                else if (v >= INT32_MIN) { out.push_back('i'); append<int32_t>(out, v); }
+                else throw std::runtime_error{"SAM error: integer tag out of range"};
+            } else {
+                if (v <= UINT8_MAX)       { out.push_back('C'); append<uint8_t>(out, v); }
+                else if (v <= UINT16_MAX) { out.push_back('S'); append<uint16_t>(out, v); }
+                else if (v <= UINT32_MAX) { out.push_back('I'); append<uint32_t>(out, v); }
+                else throw std::runtime_error{"SAM error: integer tag out of range"};
+            }
+            return;
+        }
+        case 'f':
+            out.push_back('f');
+            append<float>(out, parse<float>(t.value));
+            return;
+        case 'Z': case 'H':
+            out.push_back(t.type);
+            out.insert(out.end(), t.value.begin(), t.value.end());
+            out.push_back('\0');
+            return;
+        case 'B': {
+            auto subtype = t.arrayType();
+            if (ivio::bam::tag::elementSize(subtype) == 0 or subtype == 'A') {
+                throw std::runtime_error{"SAM error: unknown array type"};
+            }
+            out.push_back('B');
+            out.push_back(subtype);
+            auto countPos = out.size();
+            append<uint32_t>(out, 0);
+            uint32_t count{};
+            auto data = t.arrayData();
+            while (!data.empty()) {
+                auto comma = std::min(data.find(','), data.size());
+                auto e = data.substr(0, comma);
+                switch (subtype) {
+                    case 'c': append(out, parse<int8_t>(e)); break;
+                    case 'C': append(out, parse<uint8_t>(e)); break;
+                    case 's': append(out, parse<int16_t>(e)); break;
+                    case 'S': append(out, parse<uint16_t>(e)); break;
+                    case 'i': append(out, parse<int32_t>(e)); break;
+                    case 'I': append(out, parse<uint32_t>(e)); break;
+                    case 'f': append(out, parse<float>(e)); break;
+                }
+                count += 1;
+                data = data.substr(std::min(comma+1, data.size()));
+            }
+            std::memcpy(out.data() + countPos, &count, sizeof(count));
+            return;
+        }
+    }
+    throw std::runtime_error{std::string{"SAM error: unknown tag type "} + t.type};
+}
+
+void decodeTag(ivio::bam::tag const& t, std::string& out) {
+    out += t.key;
+    out += ':';
+    switch (t.type) {
+        case 'A':
+            out += "A:";
+            out += *t.asChar();
+            return;
+        case 'c': case 'C': case 's': case 'S': case 'i': case 'I':
+            out += "i:";
+            appendNumber(out, *t.asInt());
+            return;
+        case 'f':
+            out += "f:";
+            appendNumber(out, *t.asFloat());
+            return;
+        case 'Z': case 'H':
+            out += t.type;
+            out += ':';
+            out += *t.asString();
+            return;
+        case 'B': {
+            out += "B:";
+            out += t.arrayType();
+            for (size_t i{0}; i < t.arraySize(); ++i) {
+                out += ',';
+                if (t.arrayType() == 'f') appendNumber(out, t.arrayAt<float>(i));
+                else                      appendNumber(out, t.arrayAt<int64_t>(i));
+            }
+            return;
+        }
+    }
+}
+}
+
+namespace ivio::bam {
+
+auto headerFromSam(std::string_view text) -> bam::header {
+    auto header = bam::header{};
+    header.buffer = text;
+    while (!text.empty()) {
+        auto lineEnd = std::min(text.find('\n'), text.size());
+        auto line    = text.substr(0, lineEnd);
+        text         = text.substr(std::min(lineEnd+1, text.size()));
+        if (!line.starts_with("@SQ\t")) continue;
+
+        auto name   = std::string_view{};
+        auto length = uint32_t{};
+        while (!line.empty()) {
+            auto fieldEnd = std::min(line.find('\t'), line.size());
+            auto field    = line.substr(0, fieldEnd);
+            line          = line.substr(std::min(fieldEnd+1, line.size()));
+            if (field.starts_with("SN:")) name   = field.substr(3);
+            if (field.starts_with("LN:")) length = parse<uint32_t>(field.substr(3));
+        }
+        header.referenceNames.push(name);
+        header.referenceLengths.push_back(length);
+    }
+    return header;
+}
+
+auto headerToSam(bam::header const& header) -> std::string {
+    auto text = header.buffer;
+    while (!text.empty() and text.back() == '\0') text.pop_back(); // some writers pad the header text
+    if (text.starts_with("@SQ\t") or text.find("\n@SQ\t") != std::string::npos) return text;
+    for (size_t i{0}; i < header.referenceNames.size(); ++i) {
+        text += "@SQ\tSN:";
+        text += header.referenceName(i);
+        text += "\tLN:";
+        appendNumber(text, header.referenceLength(i));
+        text += '\n';
+    }
+    return text;
+}
+
+auto sam_encoder::operator()(sam::record_view const& r) -> bam::record_view {
+    auto refId = [&](std::string_view name) -> int32_t {
+        if (name == "*" or name.empty()) return -1;
+        if (auto id = header.referenceId(name)) return *id;
+        throw std::runtime_error{"SAM error: unknown reference " + std::string{name}};
+    };
+    auto refID      = refId(r.rname);
+    auto next_refID = (r.rnext == "=") ? refID : refId(r.rnext);
+
+    auto seqView = (r.seq == "*") ? std::string_view{} : r.seq;
+    parseCigar(r.cigar, cigar);
+    encodeSeq(seqView, seq);
+
+    qual.clear();
+    if (r.qual != "*" and !r.qual.empty()) {
+        if (r.qual.size() != seqView.size()) throw std::runtime_error{"SAM error: sequence and quality differ in length"};
+        qual.resize(r.qual.size());
+        for (size_t i{0}; i < r.qual.size(); ++i) {
+            qual[i] = r.qual[i] - 33;
+        }
+    }
+
+    tags.clear();
+    for (auto t : r.tagRange()) {
+        encodeTag(t, tags);
+    }
+
+    return bam::record_view {
+        .refID      = refID,
+        .pos        = r.pos - 1,
+        .mapq       = static_cast<uint8_t>(r.mapq),
+        .bin        = 0, // computed by bam::writer
+        .flag       = static_cast<uint16_t>(r.flag),
+        .next_refID = next_refID,
+        .next_pos   = r.pnext - 1,
+        .tlen       = r.tlen,
+        .read_name  = r.qname,
+        .cigar      = cigar,
+        .seq        = {seq, seqView.size()},
+        .qual       = qual,
+        .tags       = tags,
+    };
+}
+
+auto sam_decoder::operator()(bam::record_view const& r) -> sam::record_view {
+    auto refName = [&](int32_t id) -> std::string_view {
+        if (id < 0 or size_t(id) >= header.referenceNames.size()) return "*";
+        return header.referenceName(id);
+    };
+
+    auto qname = r.read_name;
+    if (qname.ends_with('\0')) qname.remove_suffix(1);
+
+    cigar.clear();
+    for (auto op : r.cigarView()) {
+        appendNumber(cigar, op.len);
+        cigar += op.opChar();
+    }
+
+    seq.resize(r.seq.size);
+    r.seq.decode_into(seq);
+
+    qual.clear();
+    if (!r.qual.empty() and r.qual[0] != 0xff) {
+        qual.resize(r.qual.size());
+        r.decode_qual_into(qual);
+    }
+
+    tags.clear();
+    for (auto t : r.tagRange()) {
+        if (!tags.empty()) tags += '\t';
+        decodeTag(t, tags);
+    }
+
+    auto rnext = (r.next_refID >= 0 and r.next_refID == r.refID) ? std::string_view{"="} : refName(r.next_refID);
+
+    return sam::record_view {
+        .qname = qname,
+        .flag  = r.flag,
+        .rname = refName(r.refID),
+        .pos   = r.pos + 1,
+        .mapq  = r.mapq,
+        .cigar = cigar,
+        .rnext = rnext,
+        .pnext = r.next_pos + 1,
+        .tlen  = r.tlen,
+        .seq   = seq,
+        .qual  = qual,
+        .tags  = tags,
+    };
+}
+
+void samToBam(sam::reader::config input, bam::writer::config output) {
+    auto reader   = sam::reader{input};
+    output.header = headerFromSam(reader.header());
+    auto writer   = bam::writer{output};
+    auto encode   = sam_encoder{output.header};
+    for (auto record : reader) {
+        writer.write(encode(record));
+    }
+}
+
+void bamToSam(bam::reader::config input, sam::writer::config output) {
+    auto reader   = bam::reader{input};
+    output.header = headerToSam(reader.header());
+    auto writer   = sam::writer{output};
+    auto decode   = sam_decoder{reader.header()};
+    for (auto record : reader) {
+        writer.write(decode(record));
+    }
+}
+
+}
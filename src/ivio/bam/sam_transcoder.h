@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../sam/reader.h"
+#include "../sam/record.h"
+#include "../sam/writer.h"
+#include "header.h"
+#include "reader.h"
+#include "record.h"
+#include "writer.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ivio::bam {
+
+/*!\brief builds a bam header from sam header lines, references are taken from the @SQ lines
+ */
+auto headerFromSam(std::string_view text) -> bam::header;
+
+/*!\brief builds sam header lines from a bam header, @SQ lines are added if missing
+ */
+auto headerToSam(bam::header const& header) -> std::string;
+
+/*!\brief Encodes sam records as bam records
+ *
+ * The returned view points into buffers of the encoder, which are reused by the next call.
+ */
+struct sam_encoder {
+    bam::header const& header;
+
+    std::vector<uint8_t> cigar;
+    std::vector<uint8_t> seq;
+    std::vector<uint8_t> qual;
+    std::vector<uint8_t> tags;
+
+    auto operator()(sam::record_view const& record) -> bam::record_view;
+};
+
+/*!\brief Decodes bam records into sam records
+ *
+ * The returned view points into buffers of the decoder, which are reused by the next call.
+ */
+struct sam_decoder {
+    bam::header const& header;
+
+    std::string cigar;
+    std::string seq;
+    std::string qual;
+    std::string tags;
+
+    auto operator()(bam::record_view const& record) -> sam::record_view;
+};
+
+/*!\brief converts a sam file into a bam file, the header of the output is taken from the input
+ */
+void samToBam(sam::reader::config input, bam::writer::config output);
+
+/*!\brief converts a bam file into a sam file, the header of the output is taken from the input
+ */
+void bamToSam(bam::reader::config input, sam::writer::config output);
+
+}
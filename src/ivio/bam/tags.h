@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace ivio::bam {
+
+/*!\brief A single auxiliary field of a bam record, pointing into the record data
+ *
+ * type is one of A, c, C, s, S, i, I, f, Z, H or B. For Z and H the value excludes the
+ * terminating '\0', for B it starts with the subtype followed by the element count.
+ */
+struct tag {
+    std::string_view         key;
+    char                     type;
+    std::span<uint8_t const> value;
+
+    /*!\brief number of bytes of a single element of type t
+     */
+    static constexpr auto elementSize(char t) -> size_t {
+        switch (t) {
+            case 'A': case 'c': case 'C': return 1;
+            case 's': case 'S': return 2;
+            case 'i': case 'I': case 'f': return 4;
+        }
+        return 0;
+    }
+
+    template <typename T>
+    static auto load(uint8_t const* ptr) -> T {
+        T v;
+        std::memcpy(&v, ptr, sizeof(T)); // bam is little endian, as are all supported platforms
+        return v;
+    }
+
+    /*!\brief value of integer tags (c, C, s, S, i, I)
+     */
+    auto asInt() const -> std::optional<int64_t> {
+        switch (type) {
+            case 'c': return load<int8_t>(value.data());
+            case 'C': return load<uint8_t>(value.data());
+            case 's': return load<int16_t>(value.data());
+            case 'S': return load<uint16_t>(value.data());
+            case 'i': return load<int32_t>(value.data());
+            case 'I': return load<uint32_t>(value.data());
+        }
+        return std::nullopt;
+    }
+
+    auto asFloat() const -> std::optional<float> {
+        if (type != 'f') return std::nullopt;
+        return load<float>(value.data());
+    }
+
+    auto asChar() const -> std::optional<char> {
+        if (type != 'A') return std::nullopt;
+        return char(value[0]);
+    }
+
+    /*!\brief value of string tags (Z, H)
+     */
+    auto asString() const -> std::optional<std::string_view> {
+        if (type != 'Z' and type != 'H') return std::nullopt;
+        return std::string_view{reinterpret_cast<char const*>(value.data()), value.size()};
+    }
+
+    /*!\brief subtype of an array tag (B)
+     */
+    auto arrayType() const -> char {
+        if (type != 'B') return '\0';
+        return char(value[0]);
+    }
+
+    auto arraySize() const -> size_t {
+        if (type != 'B') return 0;
+        return load<uint32_t>(value.data() + 1);
+    }
+
+    /*!\brief raw little endian data of an array tag (B)
+     */
+    auto arrayData() const -> std::span<uint8_t const> {
+        if (type != 'B') return {};
+        return value.subspan(5);
+    }
+
+    /*!\brief i-th element of an array tag, converted to T
+     */
+    template <typename T>
+    auto arrayAt(size_t i) const -> T {
+        auto ptr = value.data() + 5 + i * elementSize(arrayType());
+        switch (arrayType()) {
+            case 'c': return static_cast<T>(load<int8_t>(ptr));
+            case 'C': return static_cast<T>(load<uint8_t>(ptr));
+            case 's': return static_cast<T>(load<int16_t>(ptr));
+            case 'S': return static_cast<T>(load<uint16_t>(ptr));
+            case 'i': return static_cast<T>(load<int32_t>(ptr));
+            case 'I': return static_cast<T>(load<uint32_t>(ptr));
+            case 'f': return static_cast<T>(load<float>(ptr));
+        }
+        throw std::runtime_error{"BAM error: unknown array type"};
+    }
+};
+
+/*!\brief Lazy range over the auxiliary data of a bam record
+ *
+ * Tags are decoded while iterating, no memory is allocated.
+ */
+struct tag_range {
+    std::span<uint8_t const> data;
+
+    /*!\brief decodes the tag starting at ptr
+     * \returns the tag and a pointer to the next tag
+     */
+    static auto decode(uint8_t const* ptr, uint8_t const* end) -> std::tuple<tag, uint8_t const*> {
+        if (end - ptr < 3) throw std::runtime_error{"BAM error: truncated auxiliary data"};
+        auto key  = std::string_view{reinterpret_cast<char const*>(ptr), 2};
+        auto type = char(ptr[2]);
+        auto value = ptr + 3;
+        auto size = tag::elementSize(type);
+        auto skip = size;
+        if (type == 'Z' or type == 'H') {
+            auto nul = static_cast<uint8_t const*>(std::memchr(value, '\0', end - value));
+            if (!nul) throw std::runtime_error{"BAM error: unterminated string in auxiliary data"};
+            size = nul - value;
+            skip = size + 1;
+        } else if (type == 'B') {
+            if (end - value < 5) throw std::runtime_error{"BAM error: truncated auxiliary data"};
+            auto elementSize = tag::elementSize(char(value[0]));
+            if (elementSize == 0 or value[0] == 'A') throw std::runtime_error{"BAM error: unknown array type"};
+            size = 5 + tag::load<uint32_t>(value + 1) * elementSize;
+            skip = size;
+        } else if (size == 0) {
+            throw std::runtime_error{std::string{"BAM error: unknown tag type "} + type};
+        }
+        if (size_t(end - value) < skip) throw std::runtime_error{"BAM error: truncated auxiliary data"};
+        return {tag{key, type, {value, size}}, value + skip};
+    }
+
+    struct iter {
+        using value_type      = tag;
+        using difference_type = std::ptrdiff_t;
+
+        uint8_t const* ptr{};
+        uint8_t const* end{};
+
+        auto operator*() const -> tag {
+            return std::get<0>(decode(ptr, end));
+        }
+        auto operator++() -> iter& {
+            ptr = std::get<1>(decode(ptr, end));
+            return *this;
+        }
+        auto operator++(int) -> iter {
+            auto r = *this;
+            ++*this;
+            return r;
+        }
+        auto operator==(iter const& _other) const -> bool {
+            return ptr == _other.ptr;
+        }
+    };
+
+    auto begin() const -> iter {
+        return {data.data(), data.data() + data.size()};
+    }
+    auto end() const -> iter {
+        return {data.data() + data.size(), data.data() + data.size()};
+    }
+
+    /*!\brief searches for a tag by its two character key, e.g. find("NM")
+     */
+    auto find(std::string_view key) const -> std::optional<tag> {
+        if (key.size() != 2) return std::nullopt;
+        auto ptr = data.data();
+        auto end = data.data() + data.size();
+        while (ptr != end) {
+            auto [t, next] = decode(ptr, end);
+            if (ptr[0] == uint8_t(key[0]) and ptr[1] == uint8_t(key[1])) {
+                return t;
+            }
+            ptr = next;
+        }
+        return std::nullopt;
+    }
+};
+
+}
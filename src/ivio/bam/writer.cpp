@@ -0,0 +1,224 @@
+#include "writer.h"
+
+#include "../bgzf_index.h"
+#include "../bgzf_mt_writer.h"
+#include "../bgzf_reader.h"
+#include "../bgzf_writer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <variant>
+
+namespace {
+
+struct bam_buffer {
+    std::vector<char> buffer;
+
+    void clear() {
+        buffer.clear();
+    }
+
+    template <typename T>
+    void pack(T v) {
+        auto oldSize = buffer.size();
+        buffer.resize(oldSize + sizeof(std::decay_t<T>));
+        ivio::bgzf_writer::detail::bgzfPack(v, buffer.data() + oldSize);
+    }
+
+    template <typename T>
+    void writeData(std::span<T const> data) {
+        if (data.empty()) return;
+        auto oldSize = buffer.size();
+        buffer.resize(oldSize + data.size());
+        std::memcpy(buffer.data() + oldSize, data.data(), data.size());
+    }
+
+    void fill(char c, size_t n) {
+        buffer.resize(buffer.size() + n, c);
+    }
+};
+
+struct index_entry {
+    int32_t refID;
+    int32_t pos;
+    int64_t end;
+    bool    mapped;
+};
+
+// end of the alignment on the reference, unmapped reads span a single base
+auto alignmentEnd(int32_t pos, uint16_t flag, ivio::bam::cigar_view cigar) -> int64_t {
+    if (flag & 0x4) return int64_t{pos} + 1;
+    return int64_t{pos} + std::max(int64_t{1}, cigar.referenceLength());
+}
+
+}
+
+template <>
+struct ivio::writer_base<ivio::bam::writer>::pimpl {
+    using Writers = std::variant<bgzf_file_writer,
+                                 bgzf_stream_writer,
+                                 bgzf_mt_file_writer,
+                                 bgzf_mt_stream_writer>;
+
+    Writers    writer;
+    bam_buffer buffer;
+
+    std::optional<std::filesystem::path> indexPath;
+    bgzf_index_builder                   indexBuilder;
+    size_t                               n_ref{};
+
+    pimpl(std::filesystem::path output, size_t threadNbr, int compressionLevel, bool trackOffsets)
+        : writer {[&]() -> Writers {
+            if (threadNbr == 0) {
+                return bgzf_file_writer{output, compressionLevel};
+            }
+            return bgzf_mt_file_writer{output, threadNbr, compressionLevel, 0, trackOffsets};
+        }()}
+    {}
+
+    pimpl(std::ostream& output, size_t threadNbr, int compressionLevel, bool trackOffsets)
+        : writer {[&]() -> Writers {
+            if (threadNbr == 0) {
+                return bgzf_stream_writer{output, compressionLevel};
+            }
+            return bgzf_mt_stream_writer{output, threadNbr, compressionLevel, 0, trackOffsets};
+        }()}
+    {}
+
+    // writes an encoded record, indexEntry is only called if an index is generated
+    void write(std::span<char const> data, std::invocable auto indexEntry) {
+        std::visit([&](auto& writer) {
+            auto vbegin = writer.tell();
+            writer.write(data, false);
+            if (indexPath) {
+                auto e = indexEntry();
+                auto refID = (e.pos < 0) ? -1 : e.refID;
+                indexBuilder.push(refID, e.pos, e.end, vbegin, writer.tell(), e.mapped);
+            }
+        }, writer);
+    }
+};
+
+
+namespace ivio::bam {
+
+writer::writer(config config_)
+    : writer_base{std::visit([&](auto& p) {
+        return std::make_unique<pimpl>(p, config_.threadNbr, config_.compressionLevel, config_.index.has_value());
+    }, config_.output)}
+{
+    auto const& header = config_.header;
+    pimpl_->indexPath = config_.index;
+    pimpl_->n_ref     = header.referenceNames.size();
+
+    auto& buffer = pimpl_->buffer;
+    buffer.clear();
+    buffer.writeData(std::span{"BAM\1", 4});
+    buffer.pack<int32_t>(header.buffer.size());
+    buffer.writeData(std::span{header.buffer});
+    buffer.pack<int32_t>(header.referenceNames.size());
+    for (size_t i{0}; i < header.referenceNames.size(); ++i) {
+        auto name = header.referenceNames[i];
+        buffer.pack<uint32_t>(name.size() + 1);
+        buffer.writeData(std::span{name});
+        buffer.fill('\0', 1);
+        buffer.pack<uint32_t>(i < header.referenceLengths.size() ? header.referenceLengths[i] : 0);
+    }
+
+    std::visit([&](auto& writer) {
+        writer.write(buffer.buffer, false);
+    }, pimpl_->writer);
+}
+
+writer::~writer() {
+    close();
+}
+
+void writer::write(record_view r) {
+    assert(pimpl_);
+
+    // read names in bam records are '\0' terminated, the reader includes the terminator
+    auto read_name = r.read_name;
+    if (read_name.ends_with('\0')) read_name.remove_suffix(1);
+    if (read_name.size() > 254) throw std::runtime_error{"BAM error: read name is too long"};
+
+    auto l_seq     = r.seq.size;
+    auto seqBytes  = (l_seq+1)/2;
+    if (r.seq.data.size() < seqBytes) throw std::runtime_error{"BAM error: sequence data is too short"};
+    if (!r.qual.empty() and r.qual.size() != l_seq) throw std::runtime_error{"BAM error: sequence and quality differ in length"};
+
+    auto end = alignmentEnd(r.pos, r.flag, r.cigarView());
+    auto bin = pimpl_->indexBuilder.index.reg2bin(r.pos, end);
+
+    auto block_size = 32 + read_name.size() + 1 + r.cigar.size() + seqBytes + l_seq + r.tags.size();
+
+    auto& buffer = pimpl_->buffer;
+    buffer.clear();
+    buffer.buffer.reserve(block_size + 4);
+    buffer.pack<uint32_t>(block_size);
+    buffer.pack<int32_t>(r.refID);
+    buffer.pack<int32_t>(r.pos);
+    buffer.pack<uint8_t>(read_name.size() + 1);
+    buffer.pack<uint8_t>(r.mapq);
+    buffer.pack<uint16_t>(bin);
+    buffer.pack<uint16_t>(r.cigar.size() / 4);
+    buffer.pack<uint16_t>(r.flag);
+    buffer.pack<uint32_t>(l_seq);
+    buffer.pack<int32_t>(r.next_refID);
+    buffer.pack<int32_t>(r.next_pos);
+    buffer.pack<int32_t>(r.tlen);
+    buffer.writeData(std::span{read_name});
+    buffer.fill('\0', 1);
+    buffer.writeData(r.cigar);
+    buffer.writeData(r.seq.data.subspan(0, seqBytes));
+    if (r.qual.empty()) {
+        buffer.fill('\xff', l_seq); // missing qualities
+    } else {
+        buffer.writeData(r.qual);
+    }
+    buffer.writeData(r.tags);
+
+    pimpl_->write(buffer.buffer, [&]() {
+        return index_entry{r.refID, r.pos, end, !(r.flag & 0x4)};
+    });
+}
+
+void writer::writeRaw(std::span<uint8_t const> raw) {
+    assert(pimpl_);
+
+    auto ptr = reinterpret_cast<char const*>(raw.data());
+    if (raw.size() < 36 or bgzfUnpack<uint32_t>(ptr) + size_t{4} != raw.size()) {
+        throw std::runtime_error{"BAM error: invalid raw record"};
+    }
+
+    pimpl_->write({ptr, raw.size()}, [&]() {
+        auto refID       = bgzfUnpack<int32_t>(ptr+4);
+        auto pos         = bgzfUnpack<int32_t>(ptr+8);
+        auto l_read_name = bgzfUnpack<uint8_t>(ptr+12);
+        auto n_cigar_op  = bgzfUnpack<uint16_t>(ptr+16);
+        auto flag        = bgzfUnpack<uint16_t>(ptr+18);
+        auto start_cigar = size_t{36} + l_read_name;
+        if (start_cigar + n_cigar_op*size_t{4} > raw.size()) throw std::runtime_error{"BAM error: invalid raw record"};
+        auto cigar       = cigar_view{raw.subspan(start_cigar, n_cigar_op*size_t{4})};
+        return index_entry{refID, pos, alignmentEnd(pos, flag, cigar), !(flag & 0x4)};
+    });
+}
+
+void writer::close() {
+    if (!pimpl_) return;
+    std::visit([&](auto& writer) {
+        writer.write({}, true);
+        if (pimpl_->indexPath) {
+            auto& index = pimpl_->indexBuilder.finish(pimpl_->n_ref);
+            index.transformOffsets([&](uint64_t v) { return writer.virtualOffset(v); });
+            index.save(*pimpl_->indexPath, bgzf_index::format::bai);
+        }
+    }, pimpl_->writer);
+    pimpl_.reset();
+}
+
+static_assert(record_writer_c<writer>);
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../writer_base.h"
+#include "header.h"
+#include "record.h"
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <variant>
+
+namespace ivio::bam {
+
+struct writer : writer_base<writer> {
+    using record_view = bam::record_view;
+
+    struct config {
+        // Source: file or stream
+        std::variant<std::filesystem::path, std::reference_wrapper<std::ostream>> output;
+
+        // Header, including the list of references
+        bam::header header{};
+
+        // Number of compression threads, 0 compresses on the calling thread
+        size_t threadNbr{0};
+
+        // zlib compression level (0-9)
+        int compressionLevel{6};
+
+        // If set, a .bai index is generated while writing and saved to this path on close
+        std::optional<std::filesystem::path> index{};
+    };
+
+    writer(config config_);
+    ~writer();
+
+    void write(record_view record);
+
+    /*!\brief copies an encoded record (including block_size) verbatim, e.g. record_view::raw of a record read by bam::reader
+     *
+     * Skips encoding, filtering pipelines only pay for the compression. If an index is
+     * generated, its entry is taken from the encoded record.
+     */
+    void writeRaw(std::span<uint8_t const> raw);
+    void close();
+};
+
+}
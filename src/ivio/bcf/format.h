@@ -0,0 +1,129 @@
+#pragma once
+
+#include "info.h"
+
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+
+namespace ivio::bcf {
+
+/*!\brief A single FORMAT field, holding the values of all samples
+ *
+ * The values of sample s are stored at data[s * stride()], each sample has length elements.
+ */
+struct format_field {
+    int32_t                  key;      // index into the header dictionary
+    uint8_t                  type{};
+    size_t                   length{}; // number of elements per sample
+    size_t                   n_sample{};
+    std::span<uint8_t const> data;     // raw little endian data of all samples
+
+    // number of bytes between two samples
+    auto stride() const -> size_t {
+        return length * typed_value::elementSize(type);
+    }
+
+    auto sample(size_t s) const -> typed_value {
+        return {type, length, data.subspan(s * stride(), stride())};
+    }
+
+    /*!\brief direct access to int8 values, e.g. GT with n_sample × ploidy entries
+     * \returns std::nullopt if the field is not stored as int8
+     */
+    auto int8s() const -> std::optional<std::span<int8_t const>> {
+        if (type != 1) return std::nullopt;
+        return std::span{reinterpret_cast<int8_t const*>(data.data()), data.size()};
+    }
+
+    /*!\brief widens all integer values into out (n_sample × length entries)
+     *
+     * Missing values and vector ends are mapped to INT32_MIN and INT32_MIN+1,
+     * independent of the stored width.
+     */
+    void decodeInts(std::span<int32_t> out) const {
+        auto n = n_sample * length;
+        if (out.size() < n) throw std::runtime_error{"BCF error: buffer is too small"};
+        auto ptr = data.data();
+        auto widen = [&]<typename T>(T) {
+            for (size_t i{0}; i < n; ++i) {
+                auto v = typed_value::load<T>(ptr + i*sizeof(T));
+                out[i] = (v == std::numeric_limits<T>::min())   ? INT32_MIN
+                       : (v == std::numeric_limits<T>::min()+1) ? INT32_MIN+1
+                       : int32_t{v};
+            }
+        };
+        if (type == 1)      widen(int8_t{});
+        else if (type == 2) widen(int16_t{});
+        else if (type == 3) widen(int32_t{});
+        else throw std::runtime_error{"BCF error: FORMAT field is not an integer"};
+    }
+};
+
+/*!\brief Lazy range over the FORMAT data of a bcf record
+ *
+ * Only the descriptors are read, the sample data is skipped in O(1).
+ */
+struct format_range {
+    std::span<uint8_t const> data;
+    size_t                   n_sample{};
+
+    static auto decode(uint8_t const* ptr, uint8_t const* end, size_t n_sample) -> std::tuple<format_field, uint8_t const*> {
+        auto [key, next] = typed_value::decode(ptr, end);
+        auto k = key.asInt(0);
+        if (key.length != 1 or !k) throw std::runtime_error{"BCF error: invalid format key"};
+
+        // the descriptor describes a single sample, the data of all samples follows
+        auto [type, length, dataBegin] = typed_value::decodeDescriptor(next, end);
+        auto size = length * typed_value::elementSize(type) * n_sample;
+        if (size_t(end - dataBegin) < size) throw std::runtime_error{"BCF error: truncated format value"};
+        return {format_field{*k, type, length, n_sample, {dataBegin, size}}, dataBegin + size};
+    }
+
+    struct iter {
+        using value_type      = format_field;
+        using difference_type = std::ptrdiff_t;
+
+        uint8_t const* ptr{};
+        uint8_t const* end{};
+        size_t         n_sample{};
+
+        auto operator*() const -> format_field {
+            return std::get<0>(decode(ptr, end, n_sample));
+        }
+        auto operator++() -> iter& {
+            ptr = std::get<1>(decode(ptr, end, n_sample));
+            return *this;
+        }
+        auto operator++(int) -> iter {
+            auto r = *this;
+            ++*this;
+            return r;
+        }
+        auto operator==(iter const& _other) const -> bool {
+            return ptr == _other.ptr;
+        }
+    };
+
+    auto begin() const -> iter {
+        return {data.data(), data.data() + data.size(), n_sample};
+    }
+    auto end() const -> iter {
+        return {data.data() + data.size(), data.data() + data.size(), n_sample};
+    }
+
+    /*!\brief searches for a field by its key (index into the header dictionary)
+     */
+    auto find(int32_t key) const -> std::optional<format_field> {
+        for (auto f : *this) {
+            if (f.key == key) return f;
+        }
+        return std::nullopt;
+    }
+};
+
+}
@@ -1,13 +1,153 @@
 #pragma once
 
-#include <vector>
+#include "../string_dictionary.h"
+#include "../vcf/header.h"
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace ivio::bcf {
 
 struct header {
     std::vector<std::tuple<std::string, std::string>> table;
     std::vector<std::string> genotypes;
+
+    /* Dictionaries, filled by readDictionaries()
+     *
+     * Records refer to contigs (chromId) and to FILTER, INFO and FORMAT keys by index.
+     * Indices are assigned in order of appearance or via IDX=, unused indices have an
+     * empty name. PASS is implicitly the key with index 0.
+     */
+    string_dictionary                   contigNames;
+    std::vector<int64_t>                contigLengths; // -1 if unknown
+    string_dictionary                   keys;          // shared by FILTER, INFO and FORMAT
+    std::vector<vcf::field_definition>  filters;       // indexed like keys, empty id if not a FILTER
+    std::vector<vcf::field_definition>  infos;         // indexed like keys, empty id if not an INFO
+    std::vector<vcf::field_definition>  formats;       // indexed like keys, empty id if not a FORMAT
+
+    /*!\brief parses the ##contig, ##FILTER, ##INFO and ##FORMAT lines of table
+     */
+    void readDictionaries() {
+        auto contigs    = std::vector<std::string>{};
+        contigLengths.clear();
+        auto names      = std::vector<std::string>{"PASS"};
+        auto namesToIdx = std::unordered_map<std::string, size_t>{{"PASS", 0}};
+        filters.assign(1, vcf::field_definition{.id = "PASS", .description = "All filters passed"});
+        infos.assign(1, {});
+        formats.assign(1, {});
+
+        auto place = [](auto& table, size_t idx, auto&& value) {
+            if (table.size() <= idx) table.resize(idx+1);
+            table[idx] = std::forward<decltype(value)>(value);
+        };
+
+        // every index is assigned by a header line, larger indices can not be valid
+        auto checkIdx = [&](size_t idx) {
+            if (idx > table.size()) {
+                throw std::runtime_error{"BCF error: IDX " + std::to_string(idx) + " exceeds the number of header lines"};
+            }
+        };
+
+        for (auto const& [key, value] : table) {
+            if (key == "contig") {
+                auto id     = std::string{};
+                auto idx    = std::optional<int32_t>{};
+                auto length = int64_t{-1};
+                vcf::field_definition::forEachAttribute(value, [&](std::string_view k, std::string_view v) {
+                    if (k == "ID") id = v;
+                    else if (k == "IDX") idx = vcf::field_definition::parseIdx(v);
+                    else if (k == "length") std::from_chars(v.data(), v.data() + v.size(), length);
+                });
+                auto i = idx ? size_t(*idx) : contigs.size();
+                checkIdx(i);
+                if (i < contigs.size() and !contigs[i].empty() and contigs[i] != id) {
+                    throw std::runtime_error{"BCF error: contig IDX " + std::to_string(i) + " is used by " + contigs[i] + " and " + id};
+                }
+                place(contigs, i, id);
+                if (contigLengths.size() <= i) contigLengths.resize(i+1, -1);
+                contigLengths[i] = length;
+            } else if (key == "FILTER" or key == "INFO" or key == "FORMAT") {
+                auto def = vcf::field_definition::parse(value);
+                if (def.id.empty()) throw std::runtime_error{"BCF error: header line without ID: " + value};
+
+                // the same ID (e.g. DP as INFO and FORMAT) shares a single index
+                auto i = [&]() -> size_t {
+                    if (def.idx) return *def.idx;
+                    if (auto iter = namesToIdx.find(def.id); iter != namesToIdx.end()) return iter->second;
+                    return names.size();
+                }();
+                checkIdx(i);
+                if (i < names.size() and !names[i].empty() and names[i] != def.id) {
+                    throw std::runtime_error{"BCF error: IDX " + std::to_string(i) + " is used by " + names[i] + " and " + def.id};
+                }
+                namesToIdx.try_emplace(def.id, i);
+                place(names, i, def.id);
+                if      (key == "FILTER") place(filters, i, std::move(def));
+                else if (key == "INFO")   place(infos,   i, std::move(def));
+                else                      place(formats, i, std::move(def));
+            }
+        }
+        filters.resize(names.size());
+        infos.resize(names.size());
+        formats.resize(names.size());
+
+        contigNames = {};
+        contigNames.reserve(contigs.size());
+        for (auto const& name : contigs) contigNames.push(name);
+        keys = {};
+        keys.reserve(names.size());
+        for (auto const& name : names) keys.push(name);
+    }
+
+    auto contigName(int32_t chromId) const -> std::string_view {
+        if (chromId < 0 or size_t(chromId) >= contigNames.size()) {
+            throw std::runtime_error{"BCF error: unknown contig index " + std::to_string(chromId)};
+        }
+        return contigNames[chromId];
+    }
+
+    auto contigIdx(std::string_view name) const -> std::optional<int32_t> {
+        if (name.empty()) return std::nullopt;
+        if (auto i = contigNames.find(name)) return int32_t(*i);
+        return std::nullopt;
+    }
+
+    auto keyName(int32_t idx) const -> std::string_view {
+        if (idx < 0 or size_t(idx) >= keys.size()) {
+            throw std::runtime_error{"BCF error: unknown key index " + std::to_string(idx)};
+        }
+        return keys[idx];
+    }
+
+    auto keyIdx(std::string_view name) const -> std::optional<int32_t> {
+        if (name.empty()) return std::nullopt;
+        if (auto i = keys.find(name)) return int32_t(*i);
+        return std::nullopt;
+    }
+
+    // definitions by index, nullptr if the key is not of that kind
+    auto filter(int32_t idx) const -> vcf::field_definition const* {
+        return definition(filters, idx);
+    }
+    auto info(int32_t idx) const -> vcf::field_definition const* {
+        return definition(infos, idx);
+    }
+    auto format(int32_t idx) const -> vcf::field_definition const* {
+        return definition(formats, idx);
+    }
+
+private:
+    static auto definition(std::vector<vcf::field_definition> const& table, int32_t idx) -> vcf::field_definition const* {
+        if (idx < 0 or size_t(idx) >= table.size() or table[idx].id.empty()) return nullptr;
+        return &table[idx];
+    }
 };
 
 }
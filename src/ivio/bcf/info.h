@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace ivio::bcf {
+
+/*!\brief Typed value of a bcf record, pointing into the record data
+ *
+ * type is one of 0 (missing), 1 (int8), 2 (int16), 3 (int32), 5 (float) or 7 (char).
+ */
+struct typed_value {
+    uint8_t                  type{};
+    size_t                   length{}; // number of elements
+    std::span<uint8_t const> data;     // raw little endian data
+
+    static constexpr auto elementSize(uint8_t t) -> size_t {
+        switch (t) {
+            case 0: return 0;
+            case 1: case 7: return 1;
+            case 2: return 2;
+            case 3: case 5: return 4;
+        }
+        return 0;
+    }
+
+    template <typename T>
+    static auto load(uint8_t const* ptr) -> T {
+        T v;
+        std::memcpy(&v, ptr, sizeof(T)); // bcf is little endian, as are all supported platforms
+        return v;
+    }
+
+    /*!\brief decodes the type descriptor starting at ptr
+     * \returns type, number of elements and a pointer to the data
+     */
+    static auto decodeDescriptor(uint8_t const* ptr, uint8_t const* end) -> std::tuple<uint8_t, size_t, uint8_t const*> {
+        if (ptr >= end) throw std::runtime_error{"BCF error: truncated typed value"};
+        auto type   = uint8_t(*ptr & 0x0f);
+        auto length = size_t(*ptr >> 4);
+        ptr += 1;
+        if (length == 15) {
+            // length is stored as an additional typed integer
+            auto [l, next] = decode(ptr, end);
+            if (l.length != 1) throw std::runtime_error{"BCF error: invalid length of typed value"};
+            auto v = l.asInt(0);
+            if (!v or *v < 0) throw std::runtime_error{"BCF error: invalid length of typed value"};
+            length = size_t(*v);
+            ptr    = next;
+        }
+        if (type == 4 or type == 6 or type > 7) {
+            throw std::runtime_error{"BCF error: unknown type " + std::to_string(type)};
+        }
+        return {type, length, ptr};
+    }
+
+    /*!\brief decodes the typed value starting at ptr
+     * \returns the value and a pointer behind it
+     */
+    static auto decode(uint8_t const* ptr, uint8_t const* end) -> std::tuple<typed_value, uint8_t const*> {
+        auto [type, length, data] = decodeDescriptor(ptr, end);
+        auto size = length * elementSize(type);
+        if (size_t(end - data) < size) throw std::runtime_error{"BCF error: truncated typed value"};
+        return {typed_value{type, length, {data, size}}, data + size};
+    }
+
+    /*!\brief i-th element of an integer value
+     * \returns std::nullopt for missing values and vector ends
+     */
+    auto asInt(size_t i = 0) const -> std::optional<int32_t> {
+        switch (type) {
+            case 1: {
+                auto v = load<int8_t>(data.data() + i);
+                if (v == INT8_MIN or v == INT8_MIN+1) return std::nullopt;
+                return v;
+            }
+            case 2: {
+                auto v = load<int16_t>(data.data() + i*2);
+                if (v == INT16_MIN or v == INT16_MIN+1) return std::nullopt;
+                return v;
+            }
+            case 3: {
+                auto v = load<int32_t>(data.data() + i*4);
+                if (v == INT32_MIN or v == INT32_MIN+1) return std::nullopt;
+                return v;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /*!\brief i-th element of a float value
+     * \returns std::nullopt for missing values and vector ends
+     */
+    auto asFloat(size_t i = 0) const -> std::optional<float> {
+        if (type != 5) return std::nullopt;
+        auto raw = load<uint32_t>(data.data() + i*4);
+        if (raw == 0x7F80'0001 or raw == 0x7F80'0002) return std::nullopt;
+        return load<float>(data.data() + i*4);
+    }
+
+    /*!\brief true if the i-th element pads a value shorter than length, e.g. of a FORMAT field
+     */
+    auto isVectorEnd(size_t i) const -> bool {
+        switch (type) {
+            case 1: return load<int8_t>(data.data() + i) == INT8_MIN+1;
+            case 2: return load<int16_t>(data.data() + i*2) == INT16_MIN+1;
+            case 3: return load<int32_t>(data.data() + i*4) == INT32_MIN+1;
+            case 5: return load<uint32_t>(data.data() + i*4) == 0x7F80'0002;
+            case 7: return data[i] == '\0';
+        }
+        return false;
+    }
+
+    auto asString() const -> std::optional<std::string_view> {
+        if (type != 7) return std::nullopt;
+        return std::string_view{reinterpret_cast<char const*>(data.data()), data.size()};
+    }
+
+    // flags are stored without a value
+    auto isFlag() const -> bool {
+        return type == 0 or length == 0;
+    }
+};
+
+/*!\brief A single INFO field, key is the index into the header dictionary
+ */
+struct info_field {
+    int32_t     key;
+    typed_value value;
+};
+
+/*!\brief Lazy range over the INFO data of a bcf record
+ *
+ * Fields are decoded while iterating, no memory is allocated.
+ */
+struct info_range {
+    std::span<uint8_t const> data;
+
+    static auto decode(uint8_t const* ptr, uint8_t const* end) -> std::tuple<info_field, uint8_t const*> {
+        auto [key, next]    = typed_value::decode(ptr, end);
+        auto [value, next2] = typed_value::decode(next, end);
+        auto k = key.asInt(0);
+        if (key.length != 1 or !k) throw std::runtime_error{"BCF error: invalid info key"};
+        return {info_field{*k, value}, next2};
+    }
+
+    struct iter {
+        using value_type      = info_field;
+        using difference_type = std::ptrdiff_t;
+
+        uint8_t const* ptr{};
+        uint8_t const* end{};
+
+        auto operator*() const -> info_field {
+            return std::get<0>(decode(ptr, end));
+        }
+        auto operator++() -> iter& {
+            ptr = std::get<1>(decode(ptr, end));
+            return *this;
+        }
+        auto operator++(int) -> iter {
+            auto r = *this;
+            ++*this;
+            return r;
+        }
+        auto operator==(iter const& _other) const -> bool {
+            return ptr == _other.ptr;
+        }
+    };
+
+    auto begin() const -> iter {
+        return {data.data(), data.data() + data.size()};
+    }
+    auto end() const -> iter {
+        return {data.data() + data.size(), data.data() + data.size()};
+    }
+
+    /*!\brief searches for a field by its key (index into the header dictionary)
+     */
+    auto find(int32_t key) const -> std::optional<typed_value> {
+        for (auto f : *this) {
+            if (f.key == key) return f.value;
+        }
+        return std::nullopt;
+    }
+};
+
+}
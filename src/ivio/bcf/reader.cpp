@@ -19,9 +19,6 @@
 namespace ivio {
 
 namespace {
-// helper type for the visitor #4
-template<class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
-
 struct bcf_buffer {
     char const* iter{};
     char const* end{};
@@ -67,9 +64,10 @@ struct bcf_buffer {
     }
 
     auto readFloat() -> std::optional<float> {
+       auto bits  = ivio::bgzfUnpack<uint32_t>(iter);
        auto q     = ivio::bgzfUnpack<float>(iter);
        iter += 4;
-       if (q == 0b0111'1111'1000'0000'0000'0000'0001) return std::nullopt;
+       if (bits == 0x7F80'0001) return std::nullopt; // bit pattern of a missing value
        return {q};
     }
 
@@ -86,57 +84,26 @@ struct bcf_buffer {
         return value;
     }
 
-    auto readVectorOfInt() -> std::vector<int32_t> {
-        auto [t, l] = readDescriptor();
-        if (t != 1 and t != 2 and t != 3) {
-            throw std::runtime_error("BCF error: unexpected type: " + bcf_type(t));
-        }
-        if (l == 15) {
-            l = readInt();
-        }
-        auto res = std::vector<int32_t>{};
-        res.resize(l);
-        for (auto& v : res) {
-            v = readIntOfType(t);
-        }
-        return res;
+    static auto elementSize(uint8_t t) -> size_t {
+        if (t == 0) return 0;
+        if (t == 1 or t == 7) return 1;
+        if (t == 2) return 2;
+        if (t == 3 or t == 5) return 4;
+        throw std::runtime_error{"BCF error: unknown type " + std::to_string(t)};
     }
 
-    auto readVectorOfFloat() -> std::vector<float> {
+    // jumps over a typed value, only the descriptor is read
+    void skipValue() {
         auto [t, l] = readDescriptor();
-        if (t != 5) {
-            throw std::runtime_error("BCF error: unexpected type: " + bcf_type(t));
-        }
+        size_t n = l;
         if (l == 15) {
-            l = readInt();
-        }
-        auto res = std::vector<float>{};
-        res.resize(l);
-        for (auto& v : res) {
-            v = readFloat().value();
+            auto v = readInt();
+            if (v < 0) throw std::runtime_error{"BCF error: negative length"};
+            n = size_t(v);
         }
-        return res;
-    }
-
-    auto readAny() -> std::variant<nullptr_t, int32_t, float, char, std::string_view, std::vector<int32_t>, std::vector<float>> {
-        auto [t, l] = readDescriptor();
-        if (t == 0) return nullptr;
-        if (l == 1 && 0 < t and t < 4) return readIntOfType(t);
-        if (l == 1 && t == 5) return readFloat().value();
-        if (l == 1 && t == 7) return readIntOfType(1);
-        if (l > 1 && 0 < t and t < 4) {
-            iter -= 1;
-            return readVectorOfInt();
-        }
-        if (l > 1 && t == 5) {
-            iter -= 1;
-            return readVectorOfFloat();
-        }
-        if (l > 1 && t == 7) {
-            iter -= 1;
-            return readString();
-        }
-        throw std::runtime_error{"BCF error: unknown type/length combination - " + bcf_type(t) + "/" + std::to_string(l)};
+        auto size = n * elementSize(t);
+        if (size_t(end - iter) < size) throw std::runtime_error{"BCF error: value exceeds record"};
+        iter += size;
     }
 
     template <typename CB>
@@ -157,20 +124,20 @@ struct reader_base<bcf::reader>::pimpl {
     std::vector<std::tuple<std::string, std::string>> header;
     std::vector<std::string> genotypes;
 
-    pimpl(std::filesystem::path file, size_t threadNbr)
+    pimpl(std::filesystem::path file, size_t threadNbr, std::shared_ptr<bgzf_block_cache> cache)
         : ureader {[&]() -> VarBufferedReader {
             if (threadNbr == 0) {
-                return buffered_reader<1<<16>{bgzf_reader{mmap_reader{file}}};
+                return buffered_reader<1<<16>{bgzf_reader{mmap_reader{file}, cache}};
             }
-            return bgzf_mt_reader{mmap_reader{file}, threadNbr};
+            return bgzf_mt_reader{mmap_reader{file}, threadNbr, cache};
         }()}
     {}
-    pimpl(std::istream& file, size_t threadNbr)
+    pimpl(std::istream& file, size_t threadNbr, std::shared_ptr<bgzf_block_cache> cache)
         : ureader {[&]() -> VarBufferedReader {
             if (threadNbr == 0) {
-                return buffered_reader<1<<16>{bgzf_reader{stream_reader{file}}};
+                return buffered_reader<1<<16>{bgzf_reader{stream_reader{file}, cache}};
             }
-            return bgzf_mt_reader{stream_reader{file}, threadNbr};
+            return bgzf_mt_reader{stream_reader{file}, threadNbr, cache};
         }()}
     {}
 
@@ -210,7 +177,11 @@ struct reader_base<bcf::reader>::pimpl {
             throw std::runtime_error("faulty bcf header");
         }
 
+        // the header text is terminated by "\n\0", both are counted in txt_len
         auto tableHeader = std::string_view{ptr, txt_len-s};
+        while (!tableHeader.empty() and (tableHeader.back() == '\n' or tableHeader.back() == '\0')) {
+            tableHeader.remove_suffix(1);
+        }
         for (auto v : std::views::split(tableHeader, '\t')) {
             genotypes.emplace_back(v.begin(), v.end());
         }
@@ -260,33 +231,19 @@ struct reader_base<bcf::reader>::pimpl {
         });
 
         auto filter = buffer.capture([&]() {
-            buffer.readVectorOfInt();
+            buffer.skipValue();
         });
 
         auto info = buffer.capture([&]() {
             for (size_t i{0}; i < size_t{n_info}; ++i) {
-                auto id = buffer.readInt();
-                auto a = buffer.readAny();
-                std::visit(overloaded{
-                    [](nullptr_t) {},
-                    [](int32_t v) {},
-                    [](float v) {},
-                    [](char v) {},
-                    [](std::vector<int32_t> const& v) {},
-                    [](std::vector<float> const& v) {},
-                    [](std::string_view v) {}
-                }, a);
-            }
-        });
-        auto format = buffer.capture([&]() {
-            for (size_t i{0}; i < size_t{n_fmt}; ++i) {
-                auto id = buffer.readInt();
-                auto [t, l] = buffer.readDescriptor();
-                buffer.iter += l*t*n_sample; // Jump over the data
+                buffer.skipValue(); // key
+                buffer.skipValue(); // value
             }
         });
+        if (buffer.iter != ptr + 8 + l_shared) throw std::runtime_error{"BCF error: shared data does not match l_shared"};
 
-        assert(buffer.iter == buffer.end);
+        // the individual data is not parsed, it is accessed lazily via record_view::formatRange()
+        auto format = std::span{reinterpret_cast<uint8_t const*>(ptr + 8 + l_shared), l_indiv};
         lastUsed = l_shared + l_indiv + 8;
 
         auto r = bcf::record_view {
@@ -314,12 +271,13 @@ namespace ivio::bcf {
 
 reader::reader(config const& config_)
     : reader_base{std::visit([&](auto& p) {
-        return std::make_unique<pimpl>(p, config_.threadNbr);
+        return std::make_unique<pimpl>(p, config_.threadNbr, config_.cache);
     }, config_.input)}
 {
     pimpl_->readHeader();
     header_.table     = std::move(pimpl_->header);
     header_.genotypes = std::move(pimpl_->genotypes);
+    header_.readDictionaries();
 }
 
 reader::~reader() = default;
@@ -333,6 +291,17 @@ void reader::close() {
     pimpl_.reset();
 }
 
+auto reader::tell() -> uint64_t {
+    assert(pimpl_);
+    return pimpl_->ureader.tell(pimpl_->lastUsed);
+}
+
+void reader::seek(uint64_t voffset) {
+    assert(pimpl_);
+    pimpl_->ureader.seek(voffset);
+    pimpl_->lastUsed = 0;
+}
+
 static_assert(record_reader_c<reader>);
 
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../bgzf_block_cache.h"
 #include "../reader_base.h"
 #include "header.h"
 #include "record.h"
@@ -25,6 +26,9 @@ struct reader : public reader_base<reader> {
 
         // Value of 0 will run with a sequential implementation, other values will spawn new threads
         size_t threadNbr = 0;
+
+        // Optional cache of decompressed blocks, can be shared between readers of the same file
+        std::shared_ptr<bgzf_block_cache> cache{};
     };
 
 public:
@@ -34,6 +38,15 @@ public:
     auto header() const -> bcf::header const& { return header_; }
     auto next() -> std::optional<record_view>;
     void close();
+
+    /*!\brief virtual offset of the next record
+     * \returns compressed block offset << 16 | offset inside the uncompressed block
+     */
+    auto tell() -> uint64_t;
+
+    /*!\brief continue reading at a virtual offset previously returned by tell() or from an index
+     */
+    void seek(uint64_t voffset);
 };
 
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "format.h"
+#include "info.h"
+
 #include <cstddef>
 #include <optional>
 #include <span>
@@ -23,6 +26,16 @@ struct record_view {
     std::span<uint8_t const> filter;
     std::span<uint8_t const> info;
     std::span<uint8_t const> format;
+
+    // lazy typed access to the INFO fields, without allocations
+    auto infoRange() const -> info_range {
+        return {info};
+    }
+
+    // lazy typed access to the FORMAT fields, sample data is skipped without being read
+    auto formatRange() const -> format_range {
+        return {format, n_sample};
+    }
 };
 
 struct record {
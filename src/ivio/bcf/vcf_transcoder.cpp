@@ -0,0 +1,564 @@
+#include "vcf_transcoder.h"
+
+#include "../ordered_job_queue.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+// the smallest values of each integer type are reserved, the two smallest mark missing values and vector ends
+constexpr int32_t  int_missing      = INT32_MIN;
+constexpr int32_t  int_vector_end   = INT32_MIN+1;
+constexpr uint32_t float_missing    = 0x7F80'0001;
+constexpr uint32_t float_vector_end = 0x7F80'0002;
+
+template <typename T>
+void append(std::vector<uint8_t>& buffer, T v) {
+    auto oldSize = buffer.size();
+    buffer.resize(oldSize + sizeof(T));
+    std::memcpy(buffer.data() + oldSize, &v, sizeof(T)); // bcf is little endian, as are all supported platforms
+}
+
+template <typename T>
+void appendNumber(std::string& buffer, T v) {
+    auto oldSize = buffer.size();
+    buffer.resize(oldSize + 32);
+    auto [ptr, ec] = std::to_chars(buffer.data() + oldSize, buffer.data() + buffer.size(), v);
+    buffer.resize(ptr - buffer.data());
+}
+
+// smallest integer type (1, 2 or 3) that can hold all values, missing values and vector ends are ignored
+auto smallestIntType(std::span<int32_t const> values) -> uint8_t {
+    // branch free, so the compiler can vectorize the range check
+    int32_t lo{}, hi{};
+    for (auto v : values) {
+        auto x = (v <= int_vector_end) ? 0 : v;
+        lo = std::min(lo, x);
+        hi = std::max(hi, x);
+    }
+    if (lo >= INT8_MIN+8  and hi <= INT8_MAX)  return 1;
+    if (lo >= INT16_MIN+8 and hi <= INT16_MAX) return 2;
+    return 3;
+}
+
+template <typename T>
+void appendNarrowed(std::vector<uint8_t>& out, std::span<int32_t const> values) {
+    constexpr auto missing = std::numeric_limits<T>::min();
+    auto oldSize = out.size();
+    out.resize(oldSize + values.size() * sizeof(T));
+    auto ptr = out.data() + oldSize;
+    for (size_t i{0}; i < values.size(); ++i) {
+        auto v = values[i];
+        auto x = (v == int_missing) ? missing : (v == int_vector_end) ? T(missing+1) : T(v);
+        std::memcpy(ptr + i*sizeof(T), &x, sizeof(T));
+    }
+}
+
+void appendInts(std::vector<uint8_t>& out, uint8_t type, std::span<int32_t const> values) {
+    if (type == 1)      appendNarrowed<int8_t>(out, values);
+    else if (type == 2) appendNarrowed<int16_t>(out, values);
+    else                appendNarrowed<int32_t>(out, values);
+}
+
+void appendTypedInt(std::vector<uint8_t>& out, int32_t v) {
+    auto type = smallestIntType(std::span{&v, 1});
+    out.push_back(0x10 | type);
+    appendInts(out, type, std::span{&v, 1});
+}
+
+void appendDescriptor(std::vector<uint8_t>& out, uint8_t type, size_t length) {
+    if (length < 15) {
+        out.push_back(uint8_t(length << 4) | type);
+        return;
+    }
+    if (length > size_t{INT32_MAX}) throw std::runtime_error{"BCF error: value is too long"};
+    out.push_back(0xf0 | type);
+    appendTypedInt(out, length);
+}
+
+void appendString(std::vector<uint8_t>& out, std::string_view v) {
+    appendDescriptor(out, 7, v.size());
+    out.insert(out.end(), v.begin(), v.end());
+}
+
+auto parseInt(std::string_view v) -> int32_t {
+    if (v.empty() or v == ".") return int_missing;
+    int64_t value{};
+    auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), value);
+    if (ec != std::errc{} or ptr != v.data() + v.size() or value < INT32_MIN+8 or value > INT32_MAX) {
+        throw std::runtime_error{"VCF error: invalid integer \"" + std::string{v} + "\""};
+    }
+    return value;
+}
+
+auto parseFloat(std::string_view v) -> uint32_t {
+    if (v.empty() or v == ".") return float_missing;
+    float value{};
+    auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), value);
+    if (ec != std::errc{} or ptr != v.data() + v.size()) {
+        throw std::runtime_error{"VCF error: invalid float \"" + std::string{v} + "\""};
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// calls cb for each element of v separated by sep
+template <typename CB>
+void split(std::string_view v, char sep, CB&& cb) {
+    while (true) {
+        auto end = v.find(sep);
+        cb(v.substr(0, end));
+        if (end == std::string_view::npos) return;
+        v.remove_prefix(end+1);
+    }
+}
+
+// number of elements of a comma separated list
+auto listSize(std::string_view v) -> size_t {
+    return std::ranges::count(v, ',') + 1;
+}
+
+void appendValues(std::string& out, ivio::bcf::typed_value const& v) {
+    if (v.type == 7) {
+        auto s = *v.asString();
+        out += s.substr(0, s.find('\0'));
+        return;
+    }
+    for (size_t i{0}; i < v.length and !v.isVectorEnd(i); ++i) {
+        if (i > 0) out += ',';
+        if (v.type == 5) {
+            if (auto f = v.asFloat(i)) appendNumber(out, *f);
+            else out += '.';
+        } else {
+            if (auto x = v.asInt(i)) appendNumber(out, *x);
+            else out += '.';
+        }
+    }
+}
+
+void appendGenotype(std::string& out, ivio::bcf::typed_value const& v) {
+    for (size_t i{0}; i < v.length and !v.isVectorEnd(i); ++i) {
+        auto x = v.asInt(i).value_or(0);
+        if (i > 0) out += (x & 1) ? '|' : '/';
+        else if (x & 1) out += '|'; // leading phasing marker (VCF 4.4)
+        auto allele = (x >> 1) - 1;
+        if (allele < 0) out += '.';
+        else appendNumber(out, allele);
+    }
+}
+
+void assign(ivio::vcf::record& r, ivio::vcf::record_view const& v) {
+    // assigning each member keeps the capacity of the strings
+    r.chrom   = v.chrom;
+    r.pos     = v.pos;
+    r.id      = v.id;
+    r.ref     = v.ref;
+    r.alts    = v.alts;
+    r.qual    = v.qual;
+    r.filters = v.filters;
+    r.infos   = v.infos;
+    r.formats = v.formats;
+    r.samples = v.samples;
+}
+
+void assign(ivio::bcf::record& r, ivio::bcf::record_view const& v) {
+    r.chromId  = v.chromId;
+    r.pos      = v.pos;
+    r.rlen     = v.rlen;
+    r.qual     = v.qual;
+    r.n_info   = v.n_info;
+    r.n_allele = v.n_allele;
+    r.n_sample = v.n_sample;
+    r.n_fmt    = v.n_fmt;
+    r.id       = v.id;
+    r.ref      = v.ref;
+    r.alt.assign(v.alt.begin(), v.alt.end());
+    r.filter.assign(v.filter.begin(), v.filter.end());
+    r.info.assign(v.info.begin(), v.info.end());
+    r.format.assign(v.format.begin(), v.format.end());
+}
+
+/*!\brief Converts records in batches on worker threads, the results are written in order
+ *
+ * At most two batches per thread are held in memory.
+ */
+template <typename InRecord, typename OutRecord, typename Reader, typename Writer, typename MakeCoder>
+void transcode(Reader& reader, Writer& writer, size_t threadNbr, MakeCoder const& makeCoder) {
+    if (threadNbr == 0) {
+        auto coder = makeCoder();
+        for (auto record : reader) {
+            writer.write(coder(record));
+        }
+        return;
+    }
+
+    constexpr size_t batchSize = 1024;
+
+    struct Job {
+        std::vector<InRecord>  input;
+        std::vector<OutRecord> output;
+        size_t                 size{};
+    };
+
+    auto jobs = ivio::ordered_job_queue<Job>{threadNbr, [&]() {
+        return [coder = makeCoder()](Job& job) mutable {
+            if (job.output.size() < job.size) job.output.resize(job.size);
+            for (size_t i{0}; i < job.size; ++i) {
+                assign(job.output[i], coder(job.input[i]));
+            }
+        };
+    }};
+
+    // writes the oldest batch, after waiting for its conversion
+    auto writeFront = [&]() {
+        jobs.popFront([&](Job& job) {
+            for (size_t i{0}; i < job.size; ++i) {
+                writer.write(job.output[i]);
+            }
+        });
+    };
+
+    auto maxInFlight = threadNbr * 2;
+    auto last = false;
+    while (!last) {
+        auto job = jobs.take();
+
+        // the reader is only used by this thread, records are copied into the batch
+        job->size = 0;
+        while (job->size < batchSize) {
+            auto r = reader.next();
+            if (!r) break;
+            if (job->input.size() <= job->size) job->input.emplace_back();
+            assign(job->input[job->size], *r);
+            job->size += 1;
+        }
+        last = job->size < batchSize;
+
+        jobs.push(std::move(job));
+        while (jobs.size() >= maxInFlight or jobs.frontDone()) {
+            writeFront();
+        }
+    }
+    while (jobs.size() > 0) {
+        writeFront();
+    }
+}
+}
+
+namespace ivio::bcf {
+
+auto headerFromVcf(vcf::header const& header) -> bcf::header {
+    auto res = bcf::header{};
+    res.table     = header.table;
+    res.genotypes = header.genotypes;
+    res.readDictionaries();
+    return res;
+}
+
+auto headerToVcf(bcf::header const& header) -> vcf::header {
+    auto res = vcf::header{};
+    res.table     = header.table;
+    res.genotypes = header.genotypes;
+    res.readDefinitions();
+    return res;
+}
+
+auto vcf_encoder::operator()(vcf::record_view const& r) -> bcf::record_view {
+    using definition_t = vcf::field_definition const* (bcf::header::*)(int32_t) const;
+    auto keyIdx = [&](std::string_view key, definition_t definition, std::string_view column) -> int32_t {
+        auto idx = header.keyIdx(key);
+        if (!idx or !(header.*definition)(*idx)) {
+            throw std::runtime_error{"VCF error: " + std::string{column} + " " + std::string{key} + " is not declared in the header"};
+        }
+        return *idx;
+    };
+
+    auto chromId = header.contigIdx(r.chrom);
+    if (!chromId) throw std::runtime_error{"VCF error: contig " + std::string{r.chrom} + " is not declared in the header"};
+
+    int32_t rlen = r.ref.size();
+
+    alt.clear();
+    size_t n_allele{1};
+    if (r.alts != ".") {
+        split(r.alts, ',', [&](std::string_view a) {
+            appendString(alt, a);
+            n_allele += 1;
+        });
+    }
+
+    filter.clear();
+    if (r.filters == "." or r.filters.empty()) {
+        appendDescriptor(filter, 0, 0);
+    } else {
+        ints.clear();
+        split(r.filters, ';', [&](std::string_view f) {
+            ints.push_back(keyIdx(f, &bcf::header::filter, "FILTER"));
+        });
+        auto type = smallestIntType(ints);
+        appendDescriptor(filter, type, ints.size());
+        appendInts(filter, type, ints);
+    }
+
+    info.clear();
+    size_t n_info{};
+    if (r.infos != "." and !r.infos.empty()) {
+        split(r.infos, ';', [&](std::string_view entry) {
+            auto eq    = entry.find('=');
+            auto key   = entry.substr(0, eq);
+            auto value = (eq == std::string_view::npos) ? std::string_view{} : entry.substr(eq+1);
+            auto idx   = keyIdx(key, &bcf::header::info, "INFO");
+            auto const& type = header.info(idx)->type;
+
+            appendTypedInt(info, idx);
+            if (type == "Flag" or eq == std::string_view::npos) {
+                appendDescriptor(info, 0, 0);
+            } else if (type == "Integer") {
+                ints.clear();
+                split(value, ',', [&](std::string_view v) { ints.push_back(parseInt(v)); });
+                auto t = smallestIntType(ints);
+                appendDescriptor(info, t, ints.size());
+                appendInts(info, t, ints);
+                if (key == "END" and ints.size() == 1 and ints[0] != int_missing) {
+                    rlen = ints[0] - (r.pos - 1);
+                }
+            } else if (type == "Float") {
+                floats.clear();
+                split(value, ',', [&](std::string_view v) { floats.push_back(parseFloat(v)); });
+                appendDescriptor(info, 5, floats.size());
+                for (auto f : floats) append(info, f);
+            } else {
+                appendString(info, value);
+            }
+            n_info += 1;
+        });
+    }
+
+    format.clear();
+    size_t n_fmt{};
+    auto n_sample = header.genotypes.size();
+    if (r.formats != "." and !r.formats.empty()) {
+        n_fmt = std::ranges::count(r.formats, ':') + 1;
+
+        // split all samples once, omitted trailing fields and empty values are missing
+        fields.assign(n_sample * n_fmt, ".");
+        if (n_sample > 0) {
+            size_t sample{};
+            split(r.samples, '\t', [&](std::string_view s) {
+                if (sample >= n_sample) throw std::runtime_error{"VCF error: more samples than declared in the header"};
+                size_t k{};
+                split(s, ':', [&](std::string_view v) {
+                    if (k < n_fmt and !v.empty()) fields[sample * n_fmt + k] = v; // empty values are missing
+                    k += 1;
+                });
+                sample += 1;
+            });
+        }
+        auto sampleValue = [&](size_t sample, size_t k) {
+            return fields[sample * n_fmt + k];
+        };
+
+        size_t k{};
+        split(r.formats, ':', [&](std::string_view key) {
+            auto idx = keyIdx(key, &bcf::header::format, "FORMAT");
+            auto const& type = header.format(idx)->type;
+            appendTypedInt(format, idx);
+
+            if (key == "GT") {
+                // alleles are stored as (allele+1) << 1 | phased, missing alleles as 0.
+                // A leading phasing marker (VCF 4.4, e.g. |0|1) is stored in the first allele
+                auto hasLeadingPhase = [](std::string_view v) {
+                    return !v.empty() and (v[0] == '/' or v[0] == '|');
+                };
+                size_t ploidy{1};
+                for (size_t s{0}; s < n_sample; ++s) {
+                    auto v = sampleValue(s, k);
+                    auto separators = std::ranges::count(v, '/') + std::ranges::count(v, '|') - hasLeadingPhase(v);
+                    ploidy = std::max(ploidy, size_t(separators + 1));
+                }
+                ints.assign(n_sample * ploidy, int_vector_end);
+                for (size_t s{0}; s < n_sample; ++s) {
+                    auto v = sampleValue(s, k);
+                    size_t i{};
+                    int32_t phased{};
+                    if (hasLeadingPhase(v)) {
+                        phased = (v[0] == '|');
+                        v.remove_prefix(1);
+                    }
+                    while (!v.empty()) {
+                        auto sep = std::min(v.find_first_of("/|"), v.size());
+                        auto allele = parseInt(v.substr(0, sep));
+                        if (allele != int_missing and (allele < 0 or allele >= (INT32_MAX >> 1) - 1)) throw std::runtime_error{"VCF error: invalid genotype \"" + std::string{sampleValue(s, k)} + "\""};
+                        ints[s * ploidy + i] = (allele == int_missing ? 0 : (allele + 1) << 1) | phased;
+                        i += 1;
+                        if (sep == v.size()) break;
+                        phased = (v[sep] == '|');
+                        v.remove_prefix(sep+1);
+                    }
+                }
+                auto t = smallestIntType(ints);
+                appendDescriptor(format, t, ploidy);
+                appendInts(format, t, ints);
+            } else if (type == "Integer" or type == "Float") {
+                size_t length{1};
+                for (size_t s{0}; s < n_sample; ++s) {
+                    length = std::max(length, listSize(sampleValue(s, k)));
+                }
+                if (type == "Integer") {
+                    ints.assign(n_sample * length, int_vector_end);
+                    for (size_t s{0}; s < n_sample; ++s) {
+                        size_t i{};
+                        split(sampleValue(s, k), ',', [&](std::string_view v) { ints[s * length + i++] = parseInt(v); });
+                    }
+                    auto t = smallestIntType(ints);
+                    appendDescriptor(format, t, length);
+                    appendInts(format, t, ints);
+                } else {
+                    floats.assign(n_sample * length, float_vector_end);
+                    for (size_t s{0}; s < n_sample; ++s) {
+                        size_t i{};
+                        split(sampleValue(s, k), ',', [&](std::string_view v) { floats[s * length + i++] = parseFloat(v); });
+                    }
+                    appendDescriptor(format, 5, length);
+                    for (auto f : floats) append(format, f);
+                }
+            } else {
+                // strings are padded with '\0' to the longest string
+                size_t length{1};
+                for (size_t s{0}; s < n_sample; ++s) {
+                    length = std::max(length, sampleValue(s, k).size());
+                }
+                appendDescriptor(format, 7, length);
+                for (size_t s{0}; s < n_sample; ++s) {
+                    auto v = sampleValue(s, k);
+                    format.insert(format.end(), v.begin(), v.end());
+                    format.resize(format.size() + length - v.size(), '\0');
+                }
+            }
+            k += 1;
+        });
+    }
+
+    if (n_allele > UINT16_MAX or n_info > UINT16_MAX or n_fmt > UINT8_MAX or n_sample >= (1<<24)) {
+        throw std::runtime_error{"BCF error: record has too many alleles, fields or samples"};
+    }
+
+    return bcf::record_view {
+        .chromId  = *chromId,
+        .pos      = r.pos - 1,
+        .rlen     = rlen,
+        .qual     = r.qual,
+        .n_info   = uint16_t(n_info),
+        .n_allele = uint16_t(n_allele),
+        .n_sample = uint32_t(n_sample),
+        .n_fmt    = uint8_t(n_fmt),
+        .id       = (r.id == ".") ? std::string_view{} : r.id,
+        .ref      = r.ref,
+        .alt      = alt,
+        .filter   = filter,
+        .info     = info,
+        .format   = format,
+    };
+}
+
+auto vcf_decoder::operator()(bcf::record_view const& r) -> vcf::record_view {
+    auto decodeAll = [](std::span<uint8_t const> data, auto&& cb) {
+        auto ptr = data.data();
+        auto end = ptr + data.size();
+        while (ptr < end) {
+            auto [v, next] = typed_value::decode(ptr, end);
+            cb(v);
+            ptr = next;
+        }
+    };
+
+    alts.clear();
+    decodeAll(r.alt, [&](typed_value const& v) {
+        if (!alts.empty()) alts += ',';
+        alts += *v.asString();
+    });
+    if (alts.empty()) alts = ".";
+
+    filters.clear();
+    decodeAll(r.filter, [&](typed_value const& v) {
+        for (size_t i{0}; i < v.length; ++i) {
+            if (!filters.empty()) filters += ';';
+            filters += header.keyName(v.asInt(i).value_or(-1));
+        }
+    });
+    if (filters.empty()) filters = ".";
+
+    infos.clear();
+    for (auto f : r.infoRange()) {
+        if (!infos.empty()) infos += ';';
+        infos += header.keyName(f.key);
+        if (f.value.isFlag()) continue;
+        infos += '=';
+        appendValues(infos, f.value);
+    }
+    if (infos.empty()) infos = ".";
+
+    formats.clear();
+    fields.clear();
+    for (auto f : r.formatRange()) {
+        if (!formats.empty()) formats += ':';
+        formats += header.keyName(f.key);
+        fields.push_back(f);
+    }
+
+    samples.clear();
+    if (!fields.empty()) {
+        auto gtKey = header.keyIdx("GT");
+        for (size_t s{0}; s < r.n_sample; ++s) {
+            if (s > 0) samples += '\t';
+            auto sampleStart = samples.size();
+            for (size_t k{0}; k < fields.size(); ++k) {
+                if (k > 0) samples += ':';
+                auto v = fields[k].sample(s);
+                if (fields[k].key == gtKey) appendGenotype(samples, v);
+                else appendValues(samples, v);
+            }
+            // trailing missing fields are omitted
+            while (samples.size() > sampleStart + 1 and std::string_view{samples}.ends_with(":.")) {
+                samples.resize(samples.size() - 2);
+            }
+        }
+    }
+
+    return vcf::record_view {
+        .chrom   = header.contigName(r.chromId),
+        .pos     = r.pos + 1,
+        .id      = r.id.empty() ? std::string_view{"."} : r.id,
+        .ref     = r.ref,
+        .alts    = alts,
+        .qual    = r.qual,
+        .filters = filters,
+        .infos   = infos,
+        .formats = formats,
+        .samples = samples,
+    };
+}
+
+void vcfToBcf(vcf::reader::config input, bcf::writer::config output, size_t threadNbr) {
+    auto reader   = vcf::reader{input};
+    output.header = headerFromVcf(reader.header());
+    auto writer   = bcf::writer{output};
+    transcode<vcf::record, bcf::record>(reader, writer, threadNbr, [&]() {
+        return vcf_encoder{output.header};
+    });
+}
+
+void bcfToVcf(bcf::reader::config input, vcf::writer::config output, size_t threadNbr) {
+    auto reader   = bcf::reader{input};
+    output.header = headerToVcf(reader.header());
+    auto writer   = vcf::writer{output};
+    transcode<bcf::record, vcf::record>(reader, writer, threadNbr, [&]() {
+        return vcf_decoder{reader.header()};
+    });
+}
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../vcf/header.h"
+#include "../vcf/reader.h"
+#include "../vcf/record.h"
+#include "../vcf/writer.h"
+#include "format.h"
+#include "header.h"
+#include "reader.h"
+#include "record.h"
+#include "writer.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ivio::bcf {
+
+/*!\brief builds a bcf header from a vcf header, the dictionaries are parsed from the header lines
+ */
+auto headerFromVcf(vcf::header const& header) -> bcf::header;
+
+/*!\brief builds a vcf header from a bcf header
+ */
+auto headerToVcf(bcf::header const& header) -> vcf::header;
+
+/*!\brief Encodes vcf records as bcf records
+ *
+ * INFO and FORMAT values are typed via the definitions of the header, integers are
+ * stored with the smallest width that can hold all values of a field. Contigs, filters
+ * and keys must be declared in the header.
+ *
+ * The returned view points into buffers of the encoder, which are reused by the next call.
+ */
+struct vcf_encoder {
+    bcf::header const& header;
+
+    std::vector<uint8_t> alt;
+    std::vector<uint8_t> filter;
+    std::vector<uint8_t> info;
+    std::vector<uint8_t> format;
+
+    std::vector<int32_t>          ints;   // values of a single field
+    std::vector<uint32_t>         floats; // values of a single field, as raw bits
+    std::vector<std::string_view> fields; // FORMAT values of all samples
+
+    auto operator()(vcf::record_view const& record) -> bcf::record_view;
+};
+
+/*!\brief Decodes bcf records into vcf records
+ *
+ * The returned view points into buffers of the decoder, which are reused by the next call.
+ */
+struct vcf_decoder {
+    bcf::header const& header;
+
+    std::string alts;
+    std::string filters;
+    std::string infos;
+    std::string formats;
+    std::string samples;
+
+    std::vector<format_field> fields;
+
+    auto operator()(bcf::record_view const& record) -> vcf::record_view;
+};
+
+/*!\brief converts a vcf file into a bcf file, the header of the output is taken from the input
+ *
+ * \param threadNbr number of threads encoding batches of records, 0 encodes on the calling thread
+ */
+void vcfToBcf(vcf::reader::config input, bcf::writer::config output, size_t threadNbr = 0);
+
+/*!\brief converts a bcf file into a vcf file, the header of the output is taken from the input
+ *
+ * \param threadNbr number of threads decoding batches of records, 0 decodes on the calling thread
+ */
+void bcfToVcf(bcf::reader::config input, vcf::writer::config output, size_t threadNbr = 0);
+
+}
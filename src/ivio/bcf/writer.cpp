@@ -1,13 +1,14 @@
 #include "writer.h"
 
+#include "../bgzf_index.h"
+#include "../bgzf_mt_writer.h"
 #include "../bgzf_writer.h"
 
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <variant>
 
-#include <iostream>
-
 namespace {
 template <typename T>
 inline auto bgzfPack(T v, char* buffer) -> size_t {
@@ -36,7 +37,7 @@ struct bcf_buffer {
             if constexpr (std::same_as<T, int32_t>) return 3;
             throw std::runtime_error{"BCF error, expected an int(2)"};
         }();
-        pack<uint8_t>(type);
+        pack<uint8_t>(0x10 | type); // single value
         pack(v);
     }
 
@@ -44,12 +45,15 @@ struct bcf_buffer {
         if (v.size() < 15) { // No overflow
             auto l = (v.size() << 4) | 0x07;
             pack<uint8_t>(l);
-        } else { // overflow
+        } else { // overflow, the length follows as typed int
             pack<uint8_t>(0xf7);
-            if (v.size() > 127) {
-                throw std::runtime_error{"BCF: string to long"};
+            if (v.size() <= 127) {
+                writeInt<int8_t>(v.size());
+            } else if (v.size() <= 32767) {
+                writeInt<int16_t>(v.size());
+            } else {
+                writeInt<int32_t>(v.size());
             }
-            writeInt<int8_t>(v.size());
         }
         auto oldSize = buffer.size();
         buffer.resize(buffer.size() + v.size());
@@ -57,27 +61,6 @@ struct bcf_buffer {
             buffer[oldSize+i] = v[i];
         }
     };
-    void writeVector(std::vector<int32_t> v) {
-        if (v.size() < 15) { // No overflow
-            auto l = (v.size() << 4) | 0x07;
-            pack<uint8_t>(l);
-        } else { // overflow
-            pack<uint8_t>(0xf7);
-            if (v.size() > 127) {
-                throw std::runtime_error{"BCF: string to long"};
-            }
-            writeInt<int8_t>(v.size());
-        }
-        for (auto e : v) {
-            if ( e >= std::numeric_limits<int8_t>::lowest() and e <= std::numeric_limits<int8_t>::max()) {
-                writeInt<int8_t>(e);
-            } else if ( e >= -std::numeric_limits<int16_t>::lowest() and e <= std::numeric_limits<int16_t>::max()) {
-                writeInt<int16_t>(e);
-            } else {
-                writeInt<int32_t>(e);
-            }
-        }
-    };
     void writeData(std::span<uint8_t const> data) {
         auto oldSize = buffer.size();
         buffer.resize(oldSize + data.size());
@@ -90,24 +73,33 @@ struct bcf_buffer {
 
 template <>
 struct ivio::writer_base<ivio::bcf::writer>::pimpl {
-    //!TODO support other writers
-    using Writers = std::variant<bgzf_file_writer>;
-
+    using Writers = std::variant<bgzf_file_writer,
+                                 bgzf_stream_writer,
+                                 bgzf_mt_file_writer,
+                                 bgzf_mt_stream_writer>;
 
     Writers writer;
     bcf_buffer buffer;
 
+    std::optional<std::filesystem::path> indexPath;
+    bgzf_index_builder                   indexBuilder;
+    size_t                               n_ref{};
 
-    pimpl(std::filesystem::path output)
+    pimpl(std::filesystem::path output, size_t threadNbr, int compressionLevel, size_t maxInFlight, bool trackOffsets)
         : writer {[&]() -> Writers {
-            return bgzf_file_writer{output};
+            if (threadNbr == 0) {
+                return bgzf_file_writer{output, compressionLevel};
+            }
+            return bgzf_mt_file_writer{output, threadNbr, compressionLevel, maxInFlight, trackOffsets};
         }()}
     {}
 
-    pimpl(std::ostream& output)
+    pimpl(std::ostream& output, size_t threadNbr, int compressionLevel, size_t maxInFlight, bool trackOffsets)
         : writer {[&]() -> Writers {
-            //!TODO
-            throw std::runtime_error("streams are currently not supported");
+            if (threadNbr == 0) {
+                return bgzf_stream_writer{output, compressionLevel};
+            }
+            return bgzf_mt_stream_writer{output, threadNbr, compressionLevel, maxInFlight, trackOffsets};
         }()}
     {}
 };
@@ -117,9 +109,14 @@ namespace ivio::bcf {
 
 writer::writer(config config_)
     : writer_base{std::visit([&](auto& p) {
-        return std::make_unique<pimpl>(p);
+        return std::make_unique<pimpl>(p, config_.threadNbr, config_.compressionLevel, config_.maxInFlight, config_.index.has_value());
     }, config_.output)}
 {
+    pimpl_->indexPath = config_.index;
+    for (auto const& [key, value] : config_.header.table) {
+        if (key == "contig") pimpl_->n_ref += 1;
+    }
+
     // writing the header
     std::visit([&](auto& writer) {
         // write leading table
@@ -140,21 +137,19 @@ writer::writer(config config_)
             for (auto const& s : config_.header.genotypes) {
                 ss += '\t' + s;
             }
+            ss += '\n';
         }
+        ss += '\0'; // the terminator is part of l_text
 
         auto buffer = std::array<char, 9>{'B', 'C', 'F', 2, 2};
-        bgzf_writer::detail::bgzfPack(static_cast<uint16_t>(ss.size()), &buffer[5]);
+        bgzf_writer::detail::bgzfPack(static_cast<uint32_t>(ss.size()), &buffer[5]);
         writer.write(buffer, false);
         writer.write(ss, false);
     }, pimpl_->writer);
 }
 
 writer::~writer() {
-    if (pimpl_) {
-        std::visit([&](auto& writer) {
-            writer.write({}, true);
-        }, pimpl_->writer);
-    }
+    close();
 }
 
 void writer::write(record_view r) {
@@ -172,7 +167,11 @@ void writer::write(record_view r) {
     buffer.pack<int32_t>(r.chromId);
     buffer.pack<int32_t>(r.pos);
     buffer.pack<uint32_t>(r.rlen);
-    buffer.pack<float>(r.qual.value_or(0b0111'1111'1000'0000'0000'0000'0001));
+    if (r.qual) {
+        buffer.pack<float>(*r.qual);
+    } else {
+        buffer.pack<uint32_t>(0x7F80'0001); // bit pattern of a missing value
+    }
 
     buffer.pack<int16_t>(r.n_info);
     buffer.pack<int16_t>(r.n_allele);
@@ -192,21 +191,25 @@ void writer::write(record_view r) {
     bgzfPack<uint32_t>(l_shared, buffer.buffer.data());
     bgzfPack<uint32_t>(l_indiv,  buffer.buffer.data()+4);
 
-    //std::cout << "write: " << l_shared << " " << l_indiv << " " << chromId << " " << pos << " " << rlen << " " << qual.value_or(-1.f) << " " << n_info << " " << n_allele << " " << n_sample << " " << (int)n_fmt << "\n";
-
-    //for (size_t i{0}; i < l_shared; ++i) {
-    //    std::cout << (int) buffer.buffer[i+8] << ' ';
-    //}
-    //std::cout << '\n';
-
-
-
     std::visit([&](auto& writer) {
-       writer.write(buffer.buffer, false);
+        auto vbegin = writer.tell();
+        writer.write(buffer.buffer, false);
+        if (pimpl_->indexPath) {
+            pimpl_->indexBuilder.push(r.chromId, r.pos, int64_t{r.pos} + r.rlen, vbegin, writer.tell());
+        }
     }, pimpl_->writer);
 }
 
 void writer::close() {
+    if (!pimpl_) return;
+    std::visit([&](auto& writer) {
+        writer.write({}, true);
+        if (pimpl_->indexPath) {
+            auto& index = pimpl_->indexBuilder.finish(pimpl_->n_ref);
+            index.transformOffsets([&](uint64_t v) { return writer.virtualOffset(v); });
+            index.save(*pimpl_->indexPath, bgzf_index::format::csi);
+        }
+    }, pimpl_->writer);
     pimpl_.reset();
 }
 
@@ -8,18 +8,33 @@
 #include <functional>
 #include <ostream>
 #include <memory>
+#include <optional>
 #include <variant>
 #include <span>
 
 namespace ivio::bcf {
 
 struct writer : writer_base<writer> {
+    using record_view = bcf::record_view;
+
     struct config {
         // Source: file or stream
         std::variant<std::filesystem::path, std::reference_wrapper<std::ostream>> output;
 
         // Header
         bcf::header header{};
+
+        // Number of compression threads, 0 compresses on the calling thread
+        size_t threadNbr{0};
+
+        // zlib compression level (0-9)
+        int compressionLevel{6};
+
+        // Maximal number of blocks waiting for compression or for being written, 0 selects four per thread
+        size_t maxInFlight{0};
+
+        // If set, a .csi index is generated while writing and saved to this path on close
+        std::optional<std::filesystem::path> index{};
     };
 
     writer(config config_);
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ivio {
+
+/*!\brief Thread-safe LRU cache of decompressed BGZF blocks
+ *
+ * Blocks are keyed by their compressed offset inside a single file, so a cache
+ * must not be shared between readers of different files. The cache is split
+ * into shards, each with its own lock and an equal share of the memory budget.
+ */
+struct bgzf_block_cache {
+    struct block {
+        std::string data; // decompressed content
+    };
+
+private:
+    struct shard {
+        using entry = std::pair<uint64_t, std::shared_ptr<block const>>;
+
+        std::mutex                                               mutex;
+        std::list<entry>                                         lru; // most recently used at the front
+        std::unordered_map<uint64_t, std::list<entry>::iterator> table;
+        size_t                                                   memory{};
+    };
+
+    size_t              maxShardMemory;
+    std::vector<shard>  shards;
+    std::atomic<size_t> hits_{};
+    std::atomic<size_t> misses_{};
+
+    auto shardOf(uint64_t offset) -> shard& {
+        // fibonacci hashing, offsets of neighboring blocks end up in different shards
+        auto h = (offset * 0x9E3779B97F4A7C15ull) >> 32;
+        return shards[h % shards.size()];
+    }
+
+public:
+    /*!\brief creates a cache
+     * \param maxMemory maximum number of decompressed bytes held by the cache
+     * \param shardNbr  number of independently locked shards
+     */
+    bgzf_block_cache(size_t maxMemory = size_t{256} << 20, size_t shardNbr = 16)
+        : maxShardMemory{maxMemory / std::max(shardNbr, size_t{1})}
+        , shards(std::max(shardNbr, size_t{1}))
+    {}
+
+    bgzf_block_cache(bgzf_block_cache const&) = delete;
+    bgzf_block_cache(bgzf_block_cache&&) = delete;
+    auto operator=(bgzf_block_cache const&) -> bgzf_block_cache& = delete;
+    auto operator=(bgzf_block_cache&&) -> bgzf_block_cache& = delete;
+
+    /*!\brief looks up a block
+     * \returns the block or nullptr if it is not cached
+     */
+    auto find(uint64_t offset) -> std::shared_ptr<block const> {
+        auto& s = shardOf(offset);
+        auto g = std::unique_lock{s.mutex};
+        auto iter = s.table.find(offset);
+        if (iter == s.table.end()) {
+            misses_ += 1;
+            return nullptr;
+        }
+        hits_ += 1;
+        s.lru.splice(s.lru.begin(), s.lru, iter->second);
+        return iter->second->second;
+    }
+
+    /*!\brief adds a block, evicting the least recently used blocks of the shard if required
+     */
+    void insert(uint64_t offset, std::span<char const> data) {
+        if (data.size() > maxShardMemory) return;
+
+        auto b = std::make_shared<block const>(block{{data.begin(), data.end()}});
+        auto& s = shardOf(offset);
+        auto g = std::unique_lock{s.mutex};
+        if (s.table.contains(offset)) return;
+
+        while (s.memory + data.size() > maxShardMemory and !s.lru.empty()) {
+            auto& [key, value] = s.lru.back();
+            s.memory -= value->data.size();
+            s.table.erase(key);
+            s.lru.pop_back();
+        }
+        s.lru.emplace_front(offset, std::move(b));
+        s.table.emplace(offset, s.lru.begin());
+        s.memory += data.size();
+    }
+
+    auto hits() const -> size_t {
+        return hits_;
+    }
+
+    auto misses() const -> size_t {
+        return misses_;
+    }
+
+    auto hitRate() const -> double {
+        auto total = hits() + misses();
+        if (total == 0) return 0.;
+        return double(hits()) / total;
+    }
+};
+
+}
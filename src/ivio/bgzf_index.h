@@ -0,0 +1,434 @@
+#pragma once
+
+#include "bgzf_reader.h"
+#include "bgzf_writer.h"
+#include "file_writer.h"
+#include "mmap_reader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ivio {
+
+/*!\brief In-memory representation of a binning index (.bai, .csi or .tbi)
+ *
+ * All three formats share the same UCSC binning scheme and only differ in
+ * their serialization. Chunks and offsets are BGZF virtual offsets
+ * (compressed block offset << 16 | offset inside the uncompressed block).
+ */
+struct bgzf_index {
+    enum class format { bai, csi, tbi };
+
+    struct chunk {
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    struct bin {
+        uint64_t           loffset{}; // virtual offset of the first overlapping record (csi only)
+        std::vector<chunk> chunks;
+    };
+
+    struct reference {
+        std::map<uint32_t, bin> bins;
+        std::vector<uint64_t>   intervals; // linear index, one entry per 1<<minShift window
+
+        // meta data, stored as pseudo bin
+        uint64_t refBegin{std::numeric_limits<uint64_t>::max()};
+        uint64_t refEnd{};
+        uint64_t nMapped{};
+        uint64_t nUnmapped{};
+    };
+
+    // Header of a tabix index, describing the columns of the indexed text file
+    struct tabix_header {
+        int32_t format{2};   // 0: generic, 1: SAM, 2: VCF
+        int32_t col_seq{1};
+        int32_t col_beg{2};
+        int32_t col_end{0};
+        int32_t meta{'#'};
+        int32_t skip{0};
+        std::vector<std::string> names;
+    };
+
+    // Consecutive range of records, that can be read independently
+    struct shard {
+        uint64_t begin; // virtual offset of the first record
+        uint64_t end;   // virtual offset behind the last record, max() means until end of file
+    };
+
+    int32_t minShift{14};
+    int32_t depth{5};
+    std::vector<reference>  references;
+    std::optional<uint64_t> nNoCoor;
+    tabix_header            tabix;
+
+    auto pseudoBin() const -> uint32_t {
+        return ((1u << ((depth+1)*3)) - 1) / 7 + 1;
+    }
+
+    /*!\brief computes the smallest bin containing [beg, end)
+     */
+    auto reg2bin(int64_t beg, int64_t end) const -> uint32_t {
+        auto s = minShift;
+        auto t = ((1 << depth*3) - 1) / 7;
+        --end;
+        for (auto l = depth; l > 0; --l, s += 3, t -= 1 << l*3) {
+            if (beg >> s == end >> s) return t + (beg >> s);
+        }
+        return 0;
+    }
+
+    /*!\brief first position covered by a bin
+     */
+    auto binBegin(uint32_t bin) const -> int64_t {
+        auto l = 0;
+        auto t = uint32_t{};
+        while (l < depth and bin >= t + (1u << l*3)) {
+            t += 1u << l*3;
+            ++l;
+        }
+        return int64_t{bin - t} << (minShift + (depth-l)*3);
+    }
+
+    /*!\brief replaces every virtual offset v by f(v)
+     *
+     * Used to translate positions of writers, which only know virtual offsets after writing.
+     */
+    template <typename F>
+    void transformOffsets(F&& f) {
+        auto apply = [&](uint64_t& v) {
+            if (v != std::numeric_limits<uint64_t>::max()) v = f(v);
+        };
+        for (auto& ref : references) {
+            for (auto& [binId, bin] : ref.bins) {
+                apply(bin.loffset);
+                for (auto& c : bin.chunks) {
+                    apply(c.begin);
+                    apply(c.end);
+                }
+            }
+            for (auto& o : ref.intervals) {
+                apply(o);
+            }
+            apply(ref.refBegin);
+            apply(ref.refEnd);
+        }
+    }
+
+    void save(std::filesystem::path const& path, format f) const;
+
+    /*!\brief loads a .bai, .csi or .tbi file, the format is detected by its magic string
+     */
+    static auto load(std::filesystem::path const& path) -> bgzf_index;
+
+    /*!\brief splits the indexed file into up to n shards of similar compressed size
+     *
+     * Shards start at chunk boundaries, which are always the beginning of a record.
+     * The last shard extends to the end of the file and therefore also contains
+     * records without coordinates.
+     */
+    auto shards(size_t n) const -> std::vector<shard> {
+        auto candidates = std::vector<uint64_t>{};
+        uint64_t last{};
+        for (auto const& ref : references) {
+            for (auto const& [binId, bin] : ref.bins) {
+                for (auto const& c : bin.chunks) {
+                    candidates.push_back(c.begin);
+                    last = std::max(last, c.end);
+                }
+            }
+        }
+        if (candidates.empty()) return {};
+        std::ranges::sort(candidates);
+        auto [first, end] = std::ranges::unique(candidates);
+        candidates.erase(first, end);
+
+        n = std::clamp(n, size_t{1}, candidates.size());
+        auto firstBlock = candidates.front() >> 16;
+        auto span       = (last >> 16) - firstBlock;
+
+        auto splits = std::vector<uint64_t>{candidates.front()};
+        for (size_t k{1}; k < n; ++k) {
+            auto target = (firstBlock + span * k / n) << 16;
+            auto iter = std::ranges::lower_bound(candidates, target);
+            if (iter != candidates.end() and *iter > splits.back()) {
+                splits.push_back(*iter);
+            }
+        }
+
+        auto res = std::vector<shard>{};
+        for (size_t i{0}; i < splits.size(); ++i) {
+            auto e = (i+1 < splits.size()) ? splits[i+1] : std::numeric_limits<uint64_t>::max();
+            res.push_back({splits[i], e});
+        }
+        return res;
+    }
+};
+
+/*!\brief Builds a bgzf_index from records written in coordinate sorted order
+ *
+ * Each record is reported with its (0-based, half open) reference interval and the
+ * virtual offsets of its first byte and of the byte after its end.
+ */
+struct bgzf_index_builder {
+    bgzf_index index;
+
+    void push(int32_t refID, int64_t beg, int64_t end, uint64_t vbegin, uint64_t vend, bool mapped = true) {
+        if (refID < 0) {
+            index.nNoCoor = index.nNoCoor.value_or(0) + 1;
+            return;
+        }
+        if (size_t(refID) >= index.references.size()) {
+            index.references.resize(refID+1);
+        }
+        if (end <= beg) end = beg+1;
+
+        auto& ref    = index.references[refID];
+        auto& chunks = ref.bins[index.reg2bin(beg, end)].chunks;
+        if (!chunks.empty() and chunks.back().end == vbegin) {
+            chunks.back().end = vend;
+        } else {
+            chunks.push_back({vbegin, vend});
+        }
+
+        // update linear index
+        auto firstWindow = size_t(beg >> index.minShift);
+        auto lastWindow  = size_t((end-1) >> index.minShift);
+        if (ref.intervals.size() <= lastWindow) {
+            ref.intervals.resize(lastWindow+1, std::numeric_limits<uint64_t>::max());
+        }
+        for (auto w = firstWindow; w <= lastWindow; ++w) {
+            if (ref.intervals[w] == std::numeric_limits<uint64_t>::max()) {
+                ref.intervals[w] = vbegin;
+            }
+        }
+
+        ref.refBegin = std::min(ref.refBegin, vbegin);
+        ref.refEnd   = std::max(ref.refEnd, vend);
+        if (mapped) ref.nMapped   += 1;
+        else        ref.nUnmapped += 1;
+    }
+
+    /*!\brief fills holes of the linear index and computes the loffset of each bin
+     */
+    auto finish(size_t n_ref = 0) -> bgzf_index& {
+        if (index.references.size() < n_ref) {
+            index.references.resize(n_ref);
+        }
+        for (auto& ref : index.references) {
+            uint64_t last{};
+            for (auto& o : ref.intervals) {
+                if (o == std::numeric_limits<uint64_t>::max()) o = last;
+                last = o;
+            }
+            for (auto& [binId, bin] : ref.bins) {
+                bin.loffset = std::numeric_limits<uint64_t>::max();
+                for (auto const& c : bin.chunks) {
+                    bin.loffset = std::min(bin.loffset, c.begin);
+                }
+                auto window = size_t(index.binBegin(binId) >> index.minShift);
+                if (window < ref.intervals.size()) {
+                    bin.loffset = std::min(bin.loffset, ref.intervals[window]);
+                }
+            }
+        }
+        return index;
+    }
+};
+
+inline void bgzf_index::save(std::filesystem::path const& path, format f) const {
+    auto buffer = std::string{};
+    auto pack = [&]<typename T>(T v) {
+        auto oldSize = buffer.size();
+        buffer.resize(oldSize + sizeof(v));
+        bgzf_writer::detail::bgzfPack(v, buffer.data() + oldSize);
+    };
+    auto packBins = [&](reference const& ref) {
+        auto hasMeta = ref.nMapped + ref.nUnmapped > 0;
+        pack(static_cast<int32_t>(ref.bins.size() + (hasMeta?1:0)));
+        for (auto const& [binId, bin] : ref.bins) {
+            pack(static_cast<uint32_t>(binId));
+            if (f == format::csi) pack(static_cast<uint64_t>(bin.loffset));
+            pack(static_cast<int32_t>(bin.chunks.size()));
+            for (auto const& c : bin.chunks) {
+                pack(static_cast<uint64_t>(c.begin));
+                pack(static_cast<uint64_t>(c.end));
+            }
+        }
+        if (hasMeta) {
+            pack(static_cast<uint32_t>(pseudoBin()));
+            if (f == format::csi) pack(static_cast<uint64_t>(0));
+            pack(static_cast<int32_t>(2));
+            pack(static_cast<uint64_t>(ref.refBegin));
+            pack(static_cast<uint64_t>(ref.refEnd));
+            pack(static_cast<uint64_t>(ref.nMapped));
+            pack(static_cast<uint64_t>(ref.nUnmapped));
+        }
+        if (f != format::csi) {
+            pack(static_cast<int32_t>(ref.intervals.size()));
+            for (auto o : ref.intervals) {
+                pack(static_cast<uint64_t>(o));
+            }
+        }
+    };
+
+    if (f == format::bai) {
+        buffer = std::string{"BAI\1"};
+    } else if (f == format::csi) {
+        buffer = std::string{"CSI\1"};
+        pack(static_cast<int32_t>(minShift));
+        pack(static_cast<int32_t>(depth));
+        pack(static_cast<int32_t>(0)); // no auxiliary data
+    } else if (f == format::tbi) {
+        buffer = std::string{"TBI\1"};
+    }
+    pack(static_cast<int32_t>(references.size()));
+    if (f == format::tbi) {
+        pack(static_cast<int32_t>(tabix.format));
+        pack(static_cast<int32_t>(tabix.col_seq));
+        pack(static_cast<int32_t>(tabix.col_beg));
+        pack(static_cast<int32_t>(tabix.col_end));
+        pack(static_cast<int32_t>(tabix.meta));
+        pack(static_cast<int32_t>(tabix.skip));
+        size_t l_nm{};
+        for (auto const& n : tabix.names) {
+            l_nm += n.size() + 1;
+        }
+        pack(static_cast<int32_t>(l_nm));
+        for (auto const& n : tabix.names) {
+            buffer += n;
+            buffer += '\0';
+        }
+    }
+    for (auto const& ref : references) {
+        packBins(ref);
+    }
+    if (nNoCoor) {
+        pack(static_cast<uint64_t>(*nNoCoor));
+    }
+
+    // bai files are stored uncompressed, csi and tbi are bgzf compressed
+    if (f == format::bai) {
+        auto writer = file_writer{path};
+        writer.write(buffer, true);
+    } else {
+        auto writer = bgzf_file_writer{path};
+        writer.write(buffer, true);
+    }
+}
+
+}
+
+namespace ivio {
+
+inline auto bgzf_index::load(std::filesystem::path const& path) -> bgzf_index {
+    auto buffer = std::string{};
+    {
+        auto reader = mmap_reader{path};
+        auto [ptr, size] = reader.read(2);
+        if (size >= 2 and uint8_t(ptr[0]) == 0x1f and uint8_t(ptr[1]) == 0x8b) {
+            // csi and tbi are bgzf compressed
+            auto decoder = bgzf_reader{std::move(reader)};
+            auto block = std::string(1<<16, '\0');
+            while (auto s = decoder.read(block)) {
+                buffer.append(block.data(), s);
+            }
+        } else {
+            std::tie(ptr, size) = reader.read(reader.size());
+            buffer.assign(ptr, size);
+        }
+    }
+
+    size_t pos{};
+    auto unpack = [&]<typename T>(T) -> T {
+        if (pos + sizeof(T) > buffer.size()) throw std::runtime_error{"index file is truncated: " + path.string()};
+        auto v = bgzfUnpack<T>(buffer.data() + pos);
+        pos += sizeof(T);
+        return v;
+    };
+
+    // reads a count of elements, which must fit into the remaining data
+    auto unpackCount = [&](size_t elementSize) -> size_t {
+        auto n = unpack(int32_t{});
+        if (n < 0) throw std::runtime_error{"invalid negative count in index: " + path.string()};
+        if (size_t(n) * elementSize > buffer.size() - pos) throw std::runtime_error{"index file is truncated: " + path.string()};
+        return size_t(n);
+    };
+
+    auto index = bgzf_index{};
+    auto magic = std::string_view{buffer}.substr(0, 4);
+    pos = 4;
+    auto f = [&]() {
+        if (magic == std::string_view{"BAI\1", 4}) return format::bai;
+        if (magic == std::string_view{"CSI\1", 4}) return format::csi;
+        if (magic == std::string_view{"TBI\1", 4}) return format::tbi;
+        throw std::runtime_error{"unknown index format: " + path.string()};
+    }();
+
+    if (f == format::csi) {
+        index.minShift = unpack(int32_t{});
+        index.depth    = unpack(int32_t{});
+        auto l_aux     = unpackCount(1);
+        pos += l_aux;
+    }
+    auto n_ref = unpackCount(4); // each reference has at least n_bin
+    if (f == format::tbi) {
+        index.tabix.format  = unpack(int32_t{});
+        index.tabix.col_seq = unpack(int32_t{});
+        index.tabix.col_beg = unpack(int32_t{});
+        index.tabix.col_end = unpack(int32_t{});
+        index.tabix.meta    = unpack(int32_t{});
+        index.tabix.skip    = unpack(int32_t{});
+        auto l_nm           = unpackCount(1);
+        for (auto name : std::views::split(std::string_view{buffer}.substr(pos, l_nm), '\0')) {
+            if (name.empty()) continue;
+            index.tabix.names.emplace_back(name.begin(), name.end());
+        }
+        pos += l_nm;
+    }
+
+    index.references.resize(n_ref);
+    for (auto& ref : index.references) {
+        auto n_bin = unpackCount((f == format::csi) ? 16 : 8); // bin, (loffset) and n_chunk
+        for (size_t i{0}; i < n_bin; ++i) {
+            auto binId   = unpack(uint32_t{});
+            auto loffset = (f == format::csi) ? unpack(uint64_t{}) : uint64_t{};
+            auto n_chunk = unpackCount(16);
+            if (binId == index.pseudoBin()) {
+                if (n_chunk != 2) throw std::runtime_error{"invalid meta data bin in index: " + path.string()};
+                ref.refBegin  = unpack(uint64_t{});
+                ref.refEnd    = unpack(uint64_t{});
+                ref.nMapped   = unpack(uint64_t{});
+                ref.nUnmapped = unpack(uint64_t{});
+                continue;
+            }
+            auto& bin = ref.bins[binId];
+            bin.loffset = loffset;
+            bin.chunks.resize(n_chunk);
+            for (auto& c : bin.chunks) {
+                c.begin = unpack(uint64_t{});
+                c.end   = unpack(uint64_t{});
+            }
+        }
+        if (f != format::csi) {
+            auto n_intv = unpackCount(8);
+            ref.intervals.resize(n_intv);
+            for (auto& o : ref.intervals) {
+                o = unpack(uint64_t{});
+            }
+        }
+    }
+    if (pos + 8 <= buffer.size()) {
+        index.nNoCoor = unpack(uint64_t{});
+    }
+    return index;
+}
+
+}
@@ -33,8 +33,7 @@ struct job_queue {
         };
         void await() {
             auto g = std::unique_lock{mutex};
-            if (doneflag) return;
-            cv.wait(g);
+            cv.wait(g, [&]() { return doneflag.load(); });
         }
     };
 
@@ -71,6 +70,15 @@ struct job_queue {
         finish();
     }
 
+    // Resets all jobs into an unprocessed state, workers must be stopped
+    void reset() {
+        auto g = std::unique_lock(mutex);
+        terminate = false;
+        for (auto& job : jobs) {
+            job->reset();
+        }
+    }
+
     void finish() {
         auto g = std::unique_lock(mutex);
         terminate = true;
@@ -115,11 +123,14 @@ struct bgzf_mt_reader {
         std::string_view             output_view{};
         std::string                  compressedInput;
         std::unique_ptr<ZlibContext> zlibCtx{std::make_unique<ZlibContext>()};
+        uint64_t                     offset{}; // compressed offset of this block
     };
 
     std::mutex ureaderMutex;
     VarBufferedReader reader;
 
+    std::shared_ptr<bgzf_block_cache> cache; // optional
+
     bgzf_mt::job_queue<Job>  jobs;
     std::vector<std::jthread> threads;
 
@@ -133,8 +144,14 @@ struct bgzf_mt_reader {
         {
             // copy from underlying buffer (locked)
             // into the Job buffer
+            job->job.offset = reader.tell(0);
             auto [ptr, avail_in] = reader.read(18);
-            if (avail_in == 0) return false; // End of processing
+            if (avail_in == 0) { // End of processing, report empty block
+                job->job.output_view = {job->job.decompressedOutput.data(), 0};
+                g.unlock();
+                job->done();
+                return false;
+            }
             if (avail_in < 18) throw std::runtime_error{"failed reading (1)"};
 
             size_t compressedLen = bgzfUnpack<uint16_t>(ptr + 16) + 1u;
@@ -151,12 +168,26 @@ struct bgzf_mt_reader {
         auto& zlibCtx     = job->job.zlibCtx;
         auto& output_view = job->job.output_view;
 
-        size_t size = zlibCtx->decompressBlock({input.begin(), input.size()}, {output.data(), output.size()});
+        auto size = [&]() -> size_t {
+            if (!cache) {
+                return zlibCtx->decompressBlock({input.begin(), input.size()}, {output.data(), output.size()});
+            }
+            auto offset = job->job.offset;
+            if (auto block = cache->find(offset)) {
+                std::memcpy(output.data(), block->data.data(), block->data.size());
+                return block->data.size();
+            }
+            auto size = zlibCtx->decompressBlock({input.begin(), input.size()}, {output.data(), output.size()});
+            cache->insert(offset, {output.data(), size});
+            return size;
+        }();
         output_view = {output.begin(), output.begin() + size};
         job->done();
         return false;
     }
 
+    size_t skip{}; // bytes to drop from the next block, set by seek()
+
     std::mutex gMutex;
     void startThread(size_t threadNbr) {
         while (threads.size() < threadNbr) {
@@ -168,11 +199,13 @@ struct bgzf_mt_reader {
         }
     }
 
-    bgzf_mt_reader(VarBufferedReader reader_, size_t threadNbr=1)
+    bgzf_mt_reader(VarBufferedReader reader_, size_t threadNbr=1, std::shared_ptr<bgzf_block_cache> cache_ = {})
         : reader{std::move(reader_)}
+        , cache{std::move(cache_)}
     {
-        startThread(threadNbr);
+        // jobs must exist before the workers start, they would wait for them forever otherwise
         jobs.init_jobs(threadNbr+1);
+        startThread(threadNbr);
     }
 
     bgzf_mt_reader(bgzf_mt_reader const&) = delete;
@@ -182,6 +215,8 @@ struct bgzf_mt_reader {
         _other.threads.clear();
         jobs   = std::move(_other.jobs);
         reader = std::move(_other.reader);
+        cache  = std::move(_other.cache);
+        skip   = _other.skip; // keeps a pending seek
         startThread(threadNbr);
     }
 
@@ -199,6 +234,11 @@ struct bgzf_mt_reader {
         next->await();
 
         auto& output_view = next->job.output_view;
+        if (skip > 0) {
+            if (skip > output_view.size()) throw std::runtime_error{"BGZF virtual offset points behind the block"};
+            output_view = output_view.substr(skip);
+            skip = 0;
+        }
 
         size_t size = std::min(range.size(), output_view.size());
         std::memcpy(range.data(), output_view.data(), size);
@@ -208,7 +248,39 @@ struct bgzf_mt_reader {
         }
         return size;
     }
+
+    /*!\brief virtual offset of the next byte returned by read()
+     * \returns compressed block offset << 16 | offset inside the uncompressed block,
+     *          at the end of the input the offset behind the last block
+     */
+    auto tell() -> uint64_t {
+        auto next = jobs.begin();
+        if (!next) {
+            auto g = std::unique_lock{ureaderMutex};
+            return reader.tell(0) << 16;
+        }
+        next->await();
+        auto const& job = next->job;
+        auto inBlock    = job.output_view.data() - job.decompressedOutput.data() + skip;
+        return (job.offset << 16) | inBlock;
+    }
+
+    /*!\brief continue reading at a virtual offset
+     * \param voffset compressed block offset << 16 | offset inside the uncompressed block
+     */
+    void seek(uint64_t voffset) {
+        // stop all workers and discard blocks that were decompressed ahead of time
+        auto threadNbr = threads.size();
+        jobs.finish();
+        threads.clear();
+        jobs.reset();
+
+        reader.seek(voffset >> 16);
+        skip = voffset & 0xffff;
+        startThread(threadNbr);
+    }
 };
 static_assert(Readable<bgzf_mt_reader>);
+static_assert(Seekable<bgzf_mt_reader>);
 
 }
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "bgzf_writer.h"
+#include "ordered_job_queue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ivio {
+
+/*!\brief BGZF writer, which compresses blocks on worker threads
+ *
+ * Blocks are written to the file in order by the calling thread. At most maxInFlight
+ * blocks are waiting for compression or for being written, write() blocks otherwise.
+ *
+ * The compressed size of a block is unknown until it has been compressed. Because of
+ * this tell() returns a position (block number << 16 | offset inside the block), which
+ * virtualOffset() converts into a virtual offset after the block has been written.
+ * This requires recording the offset of every block, which has to be enabled by
+ * trackOffsets, e.g. when an index is generated.
+ */
+template <writer_c Writer>
+struct bgzf_mt_writer_impl {
+    struct Job {
+        std::vector<char> input;
+        std::vector<char> output;
+    };
+
+    Writer                 file;
+    size_t                 maxInFlight;
+    bool                   trackOffsets;
+    ordered_job_queue<Job> jobs;
+
+    std::vector<char>     buffer{};
+    size_t                blockNbr{};         // number of blocks handed to the workers
+    size_t                compressedOffset{}; // number of compressed bytes written to file
+    std::vector<uint64_t> blockOffsets;       // compressed offset of each written block, if trackOffsets is set
+
+    /*!\param threadNbr        number of compression threads
+     * \param compressionLevel zlib compression level
+     * \param maxInFlight      maximal number of blocks held in memory, 0 selects four per thread
+     * \param trackOffsets     records the offset of each block, required by virtualOffset()
+     */
+    template <typename T>
+    bgzf_mt_writer_impl(T&& name, size_t threadNbr, int compressionLevel = 6, size_t maxInFlight_ = 0, bool trackOffsets_ = false)
+        : file(std::forward<T>(name))
+        , maxInFlight{maxInFlight_}
+        , trackOffsets{trackOffsets_}
+        , jobs{std::max(threadNbr, size_t{1}), [level = validateLevel(compressionLevel)]() {
+            return [zlibCtx = bgzf_writer::detail::ZlibContext{level}](Job& job) mutable {
+                job.output.resize(1<<16); // maximum size of a bgzf block
+                auto length = zlibCtx.compressBlock(job.input, job.output);
+                job.output.resize(length);
+            };
+        }}
+    {
+        threadNbr = std::max(threadNbr, size_t{1});
+        if (maxInFlight == 0) maxInFlight = threadNbr * 4;
+        maxInFlight = std::max(maxInFlight, threadNbr);
+    }
+
+    bgzf_mt_writer_impl(bgzf_mt_writer_impl&& _other) = default;
+
+    // fails on the calling thread (e.g. invalid compression level), not inside a worker
+    static auto validateLevel(int compressionLevel) -> int {
+        try {
+            [[maybe_unused]] auto zlibCtx = bgzf_writer::detail::ZlibContext{compressionLevel};
+        } catch (char const* e) {
+            throw std::runtime_error{std::string{e} + " (compression level " + std::to_string(compressionLevel) + ")"};
+        }
+        return compressionLevel;
+    }
+
+    /*!\brief waits until the oldest block is compressed and writes it to the file
+     */
+    void writeFront() {
+        jobs.popFront([&](Job& job) {
+            if (trackOffsets) blockOffsets.push_back(compressedOffset);
+            file.write(job.output, false);
+            compressedOffset += job.output.size();
+        });
+    }
+
+    void submit(std::span<char const> data) {
+        while (jobs.size() >= maxInFlight) {
+            writeFront();
+        }
+        auto job = jobs.take();
+        job->input.assign(data.begin(), data.end());
+        jobs.push(std::move(job));
+        blockNbr += 1;
+
+        // write already compressed blocks without waiting
+        while (jobs.frontDone()) {
+            writeFront();
+        }
+    }
+
+    /*!\brief position of the next byte that will be written
+     * \returns block number << 16 | offset inside the uncompressed block
+     */
+    auto tell() const -> uint64_t {
+        return (uint64_t{blockNbr} << 16) | buffer.size();
+    }
+
+    /*!\brief converts a position returned by tell() into a virtual offset
+     *
+     * Only valid for blocks that have already been written, e.g. after write(..., true),
+     * and if trackOffsets is set
+     */
+    auto virtualOffset(uint64_t pos) const -> uint64_t {
+        if (!trackOffsets) throw std::runtime_error{"BGZF error: block offsets are not tracked"};
+        return (blockOffsets.at(pos >> 16) << 16) | (pos & 0xffff);
+    }
+
+    void write(std::span<char const> out, bool finish) {
+        auto oldSize = buffer.size();
+        buffer.resize(buffer.size() + out.size());
+        std::ranges::copy(out, buffer.data() + oldSize);
+
+        constexpr auto fullLength = 65280;
+        size_t start{0};
+        while (buffer.size() - start >= fullLength) {
+            submit({buffer.data() + start, fullLength});
+            start += fullLength;
+        }
+        // move left over data to the beginning
+        std::memmove(buffer.data(), buffer.data() + start, buffer.size() - start);
+        buffer.resize(buffer.size() - start);
+
+        if (finish) {
+            if (!buffer.empty()) {
+                submit(buffer);
+                buffer.clear();
+            }
+            submit({}); // end of file marker
+            while (jobs.size() > 0) {
+                writeFront();
+            }
+        }
+    }
+};
+
+using bgzf_mt_file_writer   = bgzf_mt_writer_impl<file_writer>;
+using bgzf_mt_stream_writer = bgzf_mt_writer_impl<stream_writer>;
+
+}
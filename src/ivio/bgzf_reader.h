@@ -1,5 +1,6 @@
 #pragma once
 
+#include "bgzf_block_cache.h"
 #include "buffered_reader.h"
 #include "file_reader.h"
 #include "mmap_reader.h"
@@ -133,14 +134,20 @@ struct ZlibContext {
 struct bgzf_reader {
     VarBufferedReader reader;
     ZlibContext       zlibCtx;
+    size_t            skip{}; // bytes to drop from the next block, set by seek()
 
-    bgzf_reader(VarBufferedReader reader)
+    std::shared_ptr<bgzf_block_cache> cache; // optional
+
+    bgzf_reader(VarBufferedReader reader, std::shared_ptr<bgzf_block_cache> cache = {})
         : reader{std::move(reader)}
+        , cache{std::move(cache)}
     {}
 
     bgzf_reader(bgzf_reader const&) = delete;
     bgzf_reader(bgzf_reader&& _other)
         : reader{std::move(_other.reader)}
+        , skip{_other.skip}
+        , cache{std::move(_other.cache)}
     {}
 
     auto operator=(bgzf_reader const&) -> bgzf_reader& = delete;
@@ -161,12 +168,46 @@ struct bgzf_reader {
 
             assert(range.size() >= (1<<16));
 
-            size_t size = zlibCtx.decompressBlock({ptr+18, compressedLen-18}, {range.data(), range.size()});
+            auto size = [&]() -> size_t {
+                if (!cache) {
+                    return zlibCtx.decompressBlock({ptr+18, compressedLen-18}, {range.data(), range.size()});
+                }
+                auto offset = reader.tell(0);
+                if (auto block = cache->find(offset)) {
+                    std::memcpy(range.data(), block->data.data(), block->data.size());
+                    return block->data.size();
+                }
+                auto size = zlibCtx.decompressBlock({ptr+18, compressedLen-18}, {range.data(), range.size()});
+                cache->insert(offset, {range.data(), size});
+                return size;
+            }();
             reader.dropUntil(compressedLen);
+            if (skip > 0) {
+                if (skip > size) throw std::runtime_error{"BGZF virtual offset points behind the block"};
+                std::memmove(range.data(), range.data() + skip, size - skip);
+                size -= skip;
+                skip = 0;
+            }
             return size;
         }
     }
+
+    /*!\brief virtual offset of the next byte returned by read()
+     * \returns compressed block offset << 16 | offset inside the uncompressed block
+     */
+    auto tell() const -> uint64_t {
+        return (reader.tell(0) << 16) | skip;
+    }
+
+    /*!\brief continue reading at a virtual offset
+     * \param voffset compressed block offset << 16 | offset inside the uncompressed block
+     */
+    void seek(uint64_t voffset) {
+        reader.seek(voffset >> 16);
+        skip = voffset & 0xffff;
+    }
 };
 
 static_assert(Readable<bgzf_reader>);
+static_assert(Seekable<bgzf_reader>);
 }
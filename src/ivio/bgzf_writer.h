@@ -1,7 +1,9 @@
 #pragma once
 
 #include "file_writer.h"
+#include "stream_writer.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <cstring>
@@ -58,9 +60,9 @@ struct ZlibContext {
 
     z_stream stream{};
 
-    ZlibContext() {
+    ZlibContext(int compressionLevel = 6) {
         constexpr auto GzipWindowBits = -15; // no zlib header
-        auto status = deflateInit2(&stream, 6, Z_DEFLATED, GzipWindowBits, 8, Z_DEFAULT_STRATEGY);
+        auto status = deflateInit2(&stream, compressionLevel, Z_DEFLATED, GzipWindowBits, 8, Z_DEFAULT_STRATEGY);
         if (status != Z_OK) {
             throw "BGZF deflateInit2() failed";
         }
@@ -137,22 +139,43 @@ struct ZlibContext {
 template <writer_c Writer>
 struct bgzf_writer_impl {
     Writer      file;
+    int         compressionLevel;
     bgzf_writer::detail::ZlibContext zlibCtx;
 
     std::vector<char> buffer{};
     std::vector<char> outBuffer{};
 
+    size_t compressedOffset{}; // number of compressed bytes written to file
+
     template <typename T>
-    bgzf_writer_impl(T&& name)
+    bgzf_writer_impl(T&& name, int compressionLevel_ = 6)
         : file(std::forward<T>(name))
+        , compressionLevel{compressionLevel_}
+        , zlibCtx{compressionLevel}
     {}
 
     bgzf_writer_impl(bgzf_writer_impl&& _other)
         : file{std::move(_other.file)}
+        , compressionLevel{_other.compressionLevel}
+        , zlibCtx{compressionLevel}
+        , compressedOffset{_other.compressedOffset}
     {}
 
     ~bgzf_writer_impl() = default;
 
+    /*!\brief virtual offset of the next byte that will be written
+     * \returns compressed block offset << 16 | offset inside the uncompressed block
+     */
+    auto tell() const -> uint64_t {
+        return (uint64_t{compressedOffset} << 16) | buffer.size();
+    }
+
+    /*!\brief converts a position returned by tell() into a virtual offset
+     */
+    auto virtualOffset(uint64_t pos) const -> uint64_t {
+        return pos;
+    }
+
     void write(std::span<char const> out, bool finish) {
         auto oldSize = buffer.size();
         buffer.resize(buffer.size() + out.size());
@@ -160,12 +183,13 @@ struct bgzf_writer_impl {
 
         constexpr auto fullLength = 65280;
         auto writeData = [&](std::span<char const> v) {
-            outBuffer.resize(fullLength);
+            outBuffer.resize(1<<16); // maximum size of a bgzf block
             auto length = zlibCtx.compressBlock(v, outBuffer);
             outBuffer.resize(length);
 
             // write to file
             file.write(outBuffer, false);
+            compressedOffset += length;
 
         };
 
@@ -187,6 +211,7 @@ struct bgzf_writer_impl {
 };
 
 using bgzf_file_writer   = bgzf_writer_impl<file_writer>;
+using bgzf_stream_writer = bgzf_writer_impl<stream_writer>;
 //using bgzf_mmap_reader   = bgzf_reader_impl<mmap_reader>;
 //using bgzf_stream_reader = bgzf_reader_impl<buffered_reader<stream_reader>>;
 //
@@ -2,8 +2,11 @@
 
 #include "concepts.h"
 
+#include <algorithm>
+#include <cassert>
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 namespace ivio {
@@ -11,6 +14,10 @@ namespace ivio {
 struct VarReader {
     std::function<size_t(std::span<char>)> read;
 
+    // Only set if the underlying reader is Seekable
+    std::function<uint64_t()>              tell;
+    std::function<void(uint64_t)>          seek;
+
     VarReader() = default;
     VarReader(VarReader const&) = delete;
     VarReader(VarReader&&) = default;
@@ -21,6 +28,14 @@ struct VarReader {
         read = [sptr] (std::span<char> s) -> size_t {
             return sptr->read(s);
         };
+        if constexpr (Seekable<T>) {
+            tell = [sptr] () -> uint64_t {
+                return sptr->tell();
+            };
+            seek = [sptr] (uint64_t pos) {
+                sptr->seek(pos);
+            };
+        }
     }
     auto operator=(VarReader const&) -> VarReader& = delete;
     auto operator=(VarReader&&) -> VarReader& = default;
@@ -33,6 +48,13 @@ class buffered_reader {
     std::vector<char> buf = []() { auto vec = std::vector<char>{}; vec.reserve(minV); return vec; }();
     int inPos{};
 
+    // Position (as reported by reader.tell()) of the data of each read call
+    struct segment {
+        size_t   bufPos;
+        uint64_t pos;
+    };
+    std::vector<segment> segments;
+
 public:
     buffered_reader(VarReader reader)
         : reader{std::move(reader)}
@@ -49,8 +71,14 @@ private:
             buf.resize(buf.capacity()*2);
         }
 
+        if (reader.tell) {
+            segments.push_back({lastSize, reader.tell()});
+        }
         auto bytes_read = reader.read(std::span{buf.data() + lastSize, buf.size() - lastSize});
         buf.resize(lastSize + bytes_read);
+        if (reader.tell and bytes_read == 0) {
+            segments.pop_back();
+        }
 
         return bytes_read != 0;
     }
@@ -85,6 +113,18 @@ public:
         std::copy(begin(buf)+i, end(buf), begin(buf));
         buf.resize(buf.size()-i);
         inPos = 0;
+
+        // keep segments in sync with the buffer
+        auto iter = std::ranges::upper_bound(segments, i, {}, &segment::bufPos);
+        if (iter != segments.begin()) {
+            --iter;
+            iter->pos   += i - iter->bufPos;
+            iter->bufPos = i;
+        }
+        segments.erase(segments.begin(), iter);
+        for (auto& s : segments) {
+            s.bufPos -= i;
+        }
     }
 
     bool eof(size_t i) const {
@@ -94,9 +134,30 @@ public:
     auto string_view(size_t start, size_t end) -> std::string_view {
         return std::string_view{buf.data()+start+inPos, buf.data()+end+inPos};
     }
+
+    auto tell(size_t i) -> uint64_t {
+        if (!reader.tell) throw std::runtime_error{"reader doesn't support tell"};
+        auto idx = i + inPos;
+        if (idx >= buf.size()) {
+            return reader.tell();
+        }
+        auto iter = std::ranges::upper_bound(segments, idx, {}, &segment::bufPos);
+        assert(iter != segments.begin());
+        --iter;
+        return iter->pos + (idx - iter->bufPos);
+    }
+
+    void seek(uint64_t pos) {
+        if (!reader.seek) throw std::runtime_error{"reader doesn't support seek"};
+        reader.seek(pos);
+        buf.clear();
+        segments.clear();
+        inPos = 0;
+    }
 };
 
 static_assert(BufferedReadable<buffered_reader<>>);
+static_assert(BufferedSeekable<buffered_reader<>>);
 
 struct VarBufferedReader {
     VarBufferedReader() = default;
@@ -121,6 +182,21 @@ struct VarBufferedReader {
         string_view = [sptr] (size_t s, size_t e) {
             return sptr->string_view(s, e);
         };
+        if constexpr (BufferedSeekable<T>) {
+            tell = [sptr] (size_t s) {
+                return sptr->tell(s);
+            };
+            seek = [sptr] (uint64_t pos) {
+                sptr->seek(pos);
+            };
+        } else {
+            tell = [] (size_t) -> uint64_t {
+                throw std::runtime_error{"reader doesn't support tell"};
+            };
+            seek = [] (uint64_t) {
+                throw std::runtime_error{"reader doesn't support seek"};
+            };
+        }
     }
     template <Readable T>
     VarBufferedReader(T&& t)
@@ -135,6 +211,8 @@ struct VarBufferedReader {
     std::function<std::tuple<char const*, size_t>(size_t)> read;
     std::function<bool(size_t)>                            eof;
     std::function<std::string_view(size_t, size_t)>        string_view;
+    std::function<uint64_t(size_t)>                        tell;
+    std::function<void(uint64_t)>                          seek;
 };
 
 }
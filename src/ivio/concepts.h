@@ -34,6 +34,30 @@ concept BufferedReadable = requires(T t) {
 };
 
 
+/* \brief describes a Reader that supports random access
+ * - tell: returns the position of the next byte that `read` would return
+ * - seek: continues reading at a position previously returned by `tell`
+ *
+ * Positions must be linear inside the data returned by a single `read` call
+ */
+template <typename T>
+concept Seekable = requires(T t) {
+    { t.tell() } -> std::same_as<uint64_t>;
+    { t.seek(uint64_t{}) } -> std::same_as<void>;
+};
+
+
+/* \brief describes a BufferedReader that supports random access
+ * - tell: returns the position of a byte relative to the last dropUntil call
+ * - seek: drops all buffered data and continues at a position previously returned by `tell`
+ */
+template <typename T>
+concept BufferedSeekable = requires(T t) {
+    { t.tell(size_t{}) } -> std::same_as<uint64_t>;
+    { t.seek(uint64_t{}) } -> std::same_as<void>;
+};
+
+
 /* \brief a Reader that reads record by record
  * - next: returns an optional, which is a record or std::nullopt if not available
  */
@@ -52,7 +76,7 @@ concept writer_c = requires(T t) {
 
 template <typename T>
 concept record_writer_c = requires(T t) {
-    { t.write({}) };
+    { t.write(std::declval<typename T::record_view>()) };
     { t.close() };
 };
 
@@ -8,8 +8,97 @@
 #include "../zlib_mmap2_reader.h"
 #include "../zlib_ng_file_reader.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 static_assert(std::ranges::range<ivio::fasta::reader>, "reader must be a range (unittest)");
 
+namespace {
+
+/*!\brief searches for the first '>' and counts the newlines in front of it
+ *
+ * Works on fixed size chunks, which the compiler can vectorize.
+ */
+auto scanSequence(char const* ptr, size_t size, size_t& newlineNbr) -> size_t {
+    constexpr size_t chunkSize = 64;
+    size_t i{0};
+    for (; i + chunkSize <= size; i += chunkSize) {
+        uint8_t nl{};
+        uint8_t gt{};
+        for (size_t j{0}; j < chunkSize; ++j) {
+            nl += ptr[i+j] == '\n';
+            gt |= ptr[i+j] == '>';
+        }
+        if (gt) break;
+        newlineNbr += nl;
+    }
+    for (; i < size; ++i) {
+        if (ptr[i] == '>') return i;
+        newlineNbr += ptr[i] == '\n';
+    }
+    return size;
+}
+
+/*!\brief splits the sequence part of a record into its lines
+ * \param newlineNbr number of newlines inside of block
+ * \returns the line width, 0 if the lines differ in width
+ *
+ * Nearly all files have a constant line width. In this case the positions of the
+ * newlines are known in advance and only need to be verified.
+ */
+auto splitLines(std::string_view block, size_t newlineNbr, std::vector<std::string_view>& lines) -> size_t {
+    lines.clear();
+    if (block.empty()) return 0;
+
+    auto ptr  = block.data();
+    auto size = block.size();
+
+    auto first = static_cast<char const*>(std::memchr(ptr, '\n', size));
+    if (first == nullptr) {
+        lines.emplace_back(block);
+        return size;
+    }
+    auto width = size_t(first - ptr);
+
+    // fixed width: every (width+1)-th character is a newline and there are no others
+    if (width > 0) {
+        auto fullLines    = size / (width+1);
+        auto rest         = size % (width+1);
+        auto lastNewline  = (rest > 0 and block.back() == '\n') ? 1 : 0;
+        auto isFixed = [&]() {
+            if (fullLines + lastNewline != newlineNbr) return false;
+            for (size_t i{0}; i < fullLines; ++i) {
+                if (ptr[i * (width+1) + width] != '\n') return false;
+            }
+            return true;
+        }();
+        if (isFixed) {
+            lines.reserve(fullLines + 1);
+            for (size_t i{0}; i < fullLines; ++i) {
+                lines.emplace_back(ptr + i * (width+1), width);
+            }
+            if (rest > 0) {
+                lines.emplace_back(ptr + fullLines * (width+1), rest - lastNewline);
+            }
+            return width;
+        }
+    }
+
+    // varying line width
+    lines.reserve(newlineNbr + 1);
+    auto end = ptr + size;
+    while (ptr < end) {
+        auto nl = static_cast<char const*>(std::memchr(ptr, '\n', end - ptr));
+        if (nl == nullptr) nl = end;
+        lines.emplace_back(ptr, nl - ptr);
+        ptr = nl + 1;
+    }
+    return 0;
+}
+
+}
+
 namespace ivio {
 
 template <>
@@ -17,6 +106,8 @@ struct reader_base<fasta::reader>::pimpl {
     VarBufferedReader ureader;
     size_t lastUsed{};
     std::string s;
+    seq_encoding encoding{};
+    std::vector<std::string_view> lineViews;
 
     pimpl(std::filesystem::path file, bool)
         : ureader {[&]() -> VarBufferedReader {
@@ -46,16 +137,17 @@ reader::reader(config const& config_)
     : reader_base{std::visit([&](auto& p) {
         return std::make_unique<pimpl>(p, config_.compressed);
     }, config_.input)}
-{}
+{
+    pimpl_->encoding = config_.encoding;
+}
 
 reader::~reader() = default;
 
-auto reader::next() -> std::optional<record_view> {
+auto reader::nextSegmented() -> std::optional<segmented_record_view> {
     assert(pimpl_);
 
     auto& ureader  = pimpl_->ureader;
     auto& lastUsed = pimpl_->lastUsed;
-    auto& s        = pimpl_->s;
 
     auto startId = ureader.readUntil('>', lastUsed);
     if (ureader.eof(startId)) return std::nullopt;
@@ -64,24 +156,59 @@ auto reader::next() -> std::optional<record_view> {
     auto endId = ureader.readUntil('\n', 0);
     if (ureader.eof(endId)) return std::nullopt;
 
+    // sequence lines never contain '>', the next record starts at the next '>'
     auto startSeq = endId+1;
+    auto endSeq   = startSeq;
+    size_t newlineNbr{};
+    while (true) {
+        // read() only returns less than requested at the end of the file
+        auto requested = endSeq + (1<<16);
+        auto [ptr, size] = ureader.read(requested);
+        endSeq += scanSequence(ptr + endSeq, size - endSeq, newlineNbr);
+        if (endSeq < size or size < requested) break;
+    }
+    lastUsed = endSeq;
+
+    auto& lineViews = pimpl_->lineViews;
+    auto lineWidth  = splitLines(ureader.string_view(startSeq, endSeq), newlineNbr, lineViews);
+    size_t length{};
+    for (auto l : lineViews) {
+        length += l.size();
+    }
+
+    return segmented_record_view {
+        .id  = ureader.string_view(0, endId),
+        .seq = {
+            .lines     = lineViews,
+            .length    = length,
+            .lineWidth = lineWidth,
+        },
+    };
+}
+
+auto reader::next() -> std::optional<record_view> {
+    auto r = nextSegmented();
+    if (!r) return std::nullopt;
 
     // convert into dense string representation
+    auto& s = pimpl_->s;
     s.clear();
-    {
-        auto s2 = startSeq;
-        do {
-            auto s1 = s2;
-            s2 = ureader.readUntil('\n', s1);
-            s += ureader.string_view(s1, s2);
-            s2 += 1;
-        } while (!ureader.eof(s2) and ureader.string_view(s2, s2+1)[0] != '>');
-        lastUsed = s2;
+    if (pimpl_->encoding == seq_encoding::chars) {
+        s.reserve(r->seq.length);
+        for (auto l : r->seq.lines) {
+            s += l;
+        }
+    } else {
+        s.resize(r->seq.length);
+        size_t pos{};
+        for (auto l : r->seq.lines) {
+            alphabet::to_ranks(pimpl_->encoding, l, s.data() + pos);
+            pos += l.size();
+        }
     }
 
-
     return record_view {
-        .id  = ureader.string_view(0, endId),
+        .id  = r->id,
         .seq = s,
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../alphabet.h"
 #include "../reader_base.h"
 #include "record.h"
 
@@ -20,6 +21,9 @@ struct reader : public reader_base<reader> {
 
         // This is only relevant if a stream is being used
         bool compressed{};
+
+        // Converts the sequence into ranks while copying it out of the read buffer
+        seq_encoding encoding{seq_encoding::chars};
     };
 
 public:
@@ -27,6 +31,12 @@ public:
     ~reader();
 
     auto next() -> std::optional<record_view>;
+
+    /*!\brief Like next(), but doesn't concatenate the lines of the sequence
+     *
+     * The returned view is valid until the next call to next() or nextSegmented().
+     */
+    auto nextSegmented() -> std::optional<segmented_record_view>;
     void close();
 };
 
@@ -1,10 +1,100 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <span>
 #include <string>
 #include <string_view>
 
 namespace ivio::fasta {
 
+/*!\brief Sequence of a multi-line fasta record, viewing the lines in place
+ *
+ * No bases are copied. If all lines except the last one have the same width, lineWidth
+ * is set and operator[] is O(1).
+ */
+struct sequence_lines {
+    std::span<std::string_view const> lines;
+    size_t                            length{};    // total number of bases
+    size_t                            lineWidth{}; // 0 if the lines differ in width
+
+    struct iter {
+        using value_type      = char;
+        using difference_type = std::ptrdiff_t;
+
+        std::string_view const* line{};
+        std::string_view const* lastLine{};
+        size_t                  pos{};
+
+        // skips over empty lines
+        void normalize() {
+            while (line != lastLine and pos == line->size()) {
+                ++line;
+                pos = 0;
+            }
+        }
+
+        auto operator*() const -> char {
+            return (*line)[pos];
+        }
+        auto operator++() -> iter& {
+            ++pos;
+            normalize();
+            return *this;
+        }
+        auto operator++(int) -> iter {
+            auto r = *this;
+            ++*this;
+            return r;
+        }
+        auto operator==(iter const& _other) const -> bool {
+            return line == _other.line and pos == _other.pos;
+        }
+    };
+
+    auto begin() const -> iter {
+        auto r = iter{lines.data(), lines.data() + lines.size(), 0};
+        r.normalize();
+        return r;
+    }
+    auto end() const -> iter {
+        return {lines.data() + lines.size(), lines.data() + lines.size(), 0};
+    }
+
+    auto size() const -> size_t {
+        return length;
+    }
+
+    auto operator[](size_t i) const -> char {
+        if (lineWidth > 0) {
+            return lines[i / lineWidth][i % lineWidth];
+        }
+        for (auto l : lines) {
+            if (i < l.size()) return l[i];
+            i -= l.size();
+        }
+        return '\0';
+    }
+
+    // concatenates all lines
+    auto str() const -> std::string {
+        auto s = std::string{};
+        s.reserve(length);
+        for (auto l : lines) {
+            s += l;
+        }
+        return s;
+    }
+};
+static_assert(std::forward_iterator<sequence_lines::iter>);
+
+/*!\brief Record as returned by reader::nextSegmented(), seq views the lines of the file
+ */
+struct segmented_record_view {
+    std::string_view id;
+    sequence_lines   seq;
+};
+
 struct record_view {
     std::string_view id;
     std::string_view seq;
@@ -19,6 +109,10 @@ struct record {
         : id{v.id}
         , seq{v.seq}
     {}
+    record(segmented_record_view v)
+        : id{v.id}
+        , seq{v.seq.str()}
+    {}
 
     operator record_view() const {
         return record_view{id, seq};
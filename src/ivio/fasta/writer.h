@@ -11,6 +11,8 @@
 namespace ivio::fasta {
 
 struct writer : writer_base<writer> {
+    using record_view = fasta::record_view;
+
     struct config {
         // Source: file or stream
         std::variant<std::filesystem::path, std::reference_wrapper<std::ostream>> output;
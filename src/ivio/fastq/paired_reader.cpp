@@ -0,0 +1,70 @@
+#include "paired_reader.h"
+
+#include "../concepts.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+namespace {
+auto mateName(std::string_view id) -> std::string_view {
+    id = id.substr(0, id.find_first_of(" \t"));
+    if (id.size() >= 2 and id[id.size()-2] == '/') {
+        id.remove_suffix(2);
+    }
+    return id;
+}
+}
+
+namespace ivio {
+
+template <>
+struct reader_base<fastq::paired_reader>::pimpl {
+    fastq::reader reader1;
+    fastq::reader reader2;
+    bool          checkNames;
+
+    pimpl(fastq::reader::config const& input1, fastq::reader::config const& input2, bool checkNames)
+        : reader1{input1}
+        , reader2{input2}
+        , checkNames{checkNames}
+    {}
+};
+
+}
+
+namespace ivio::fastq {
+
+paired_reader::paired_reader(config config_)
+    : reader_base{[&]() {
+        // one decompression pipeline per mate
+        config_.input1.threadNbr = std::max(config_.input1.threadNbr, size_t{1});
+        config_.input2.threadNbr = std::max(config_.input2.threadNbr, size_t{1});
+        return std::make_unique<pimpl>(config_.input1, config_.input2, config_.checkNames);
+    }()}
+{}
+
+paired_reader::~paired_reader() = default;
+
+auto paired_reader::next() -> std::optional<record_view> {
+    assert(pimpl_);
+    auto r1 = pimpl_->reader1.next();
+    auto r2 = pimpl_->reader2.next();
+    if (!r1 and !r2) return std::nullopt;
+    if (!r1 or !r2) {
+        throw std::runtime_error{"paired fastq files have a different number of records"};
+    }
+    if (pimpl_->checkNames and mateName(r1->id) != mateName(r2->id)) {
+        throw std::runtime_error{"paired fastq records have different names: " + std::string{r1->id} + " and " + std::string{r2->id}};
+    }
+    return record_view{*r1, *r2};
+}
+
+void paired_reader::close() {
+    pimpl_.reset();
+}
+
+static_assert(record_reader_c<paired_reader>);
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../reader_base.h"
+#include "reader.h"
+#include "record.h"
+
+#include <optional>
+#include <tuple>
+
+namespace ivio::fastq {
+
+/*!\brief Reads two fastq files in lockstep, e.g. the two mates of paired-end reads
+ *
+ * Each file is decompressed on its own thread.
+ */
+struct paired_reader : public reader_base<paired_reader> {
+    using record      = std::tuple<fastq::record, fastq::record>;
+    using record_view = std::tuple<fastq::record_view, fastq::record_view>;
+
+    struct config {
+        fastq::reader::config input1; // first mates (R1)
+        fastq::reader::config input2; // second mates (R2)
+
+        // Throws if the names of two mates differ. Only the part up to the first
+        // whitespace is compared, a trailing /1 or /2 is ignored.
+        bool checkNames{};
+    };
+
+public:
+    paired_reader(config config_);
+    ~paired_reader();
+
+    auto next() -> std::optional<record_view>;
+    void close();
+};
+
+}
@@ -1,5 +1,6 @@
 #include "reader.h"
 
+#include "../async_reader.h"
 #include "../buffered_reader.h"
 #include "../file_reader.h"
 #include "../mmap_reader.h"
@@ -14,21 +15,28 @@ template <>
 struct reader_base<fastq::reader>::pimpl {
     VarBufferedReader ureader;
     size_t lastUsed{};
+    std::string s;
+    seq_encoding encoding{};
 
-    pimpl(std::filesystem::path file, bool)
+    pimpl(std::filesystem::path file, bool, size_t threadNbr)
         : ureader {[&]() -> VarBufferedReader {
             if (file.extension() == ".fq") {
                 return mmap_reader{file.c_str()};
             } else if (file.extension() == ".gz") {
+                if (threadNbr > 0) {
+                    return async_reader{zlib_reader{mmap_reader{file.c_str()}}};
+                }
                 return zlib_reader{mmap_reader{file.c_str()}};
             }
             throw std::runtime_error("unknown file extension");
         }()}
     {}
-    pimpl(std::istream& file, bool compressed)
+    pimpl(std::istream& file, bool compressed, size_t threadNbr)
         : ureader {[&]() -> VarBufferedReader {
             if (!compressed) {
                 return stream_reader{file};
+            } else if (threadNbr > 0) {
+                return async_reader{zlib_reader{stream_reader{file}}};
             } else {
                 return zlib_reader{stream_reader{file}};
             }
@@ -41,9 +49,11 @@ namespace ivio::fastq {
 
 reader::reader(config const& config_)
     : reader_base{std::visit([&](auto& p) {
-        return std::make_unique<pimpl>(p, config_.compressed);
+        return std::make_unique<pimpl>(p, config_.compressed, config_.threadNbr);
     }, config_.input)}
-{}
+{
+    pimpl_->encoding = config_.encoding;
+}
 
 reader::~reader() = default;
 
@@ -60,12 +70,10 @@ auto reader::next() -> std::optional<record_view> {
     auto endId = ureader.readUntil('\n', 0);
     if (ureader.eof(endId)) return std::nullopt;
 
+    // readUntil() reads more data if needed, eof() only reports the end of the buffered data
     auto startSeq = endId+1;
-    if (ureader.eof(startSeq)) return std::nullopt;
-
     auto endSeq = ureader.readUntil('\n', startSeq);
     if (ureader.eof(endSeq)) return std::nullopt;
-    if (ureader.eof(endSeq+1)) return std::nullopt;
 
     auto startId2 = endSeq+2;
     auto endId2 = ureader.readUntil('\n', startId2);
@@ -77,9 +85,17 @@ auto reader::next() -> std::optional<record_view> {
 
     lastUsed = endQual;
 
+    auto seq = ureader.string_view(startSeq, endSeq);
+    if (pimpl_->encoding != seq_encoding::chars) {
+        auto& s = pimpl_->s;
+        s.resize(seq.size());
+        alphabet::to_ranks(pimpl_->encoding, seq, s.data());
+        seq = s;
+    }
+
     return record_view {
         .id   = ureader.string_view(0, endId),
-        .seq  = ureader.string_view(startSeq, endSeq),
+        .seq  = seq,
         .id2  = ureader.string_view(startId2, endId2),
         .qual = ureader.string_view(startQual, endQual),
     };
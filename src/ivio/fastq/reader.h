@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../alphabet.h"
 #include "../reader_base.h"
 #include "record.h"
 
@@ -20,6 +21,12 @@ struct reader : public reader_base<reader> {
 
         // This is only relevant if a stream is being used
         bool compressed{};
+
+        // Converts the sequence into ranks while copying it out of the read buffer
+        seq_encoding encoding{seq_encoding::chars};
+
+        // Number of decompression threads, 0 decompresses on the calling thread
+        size_t threadNbr{0};
     };
 
 public:
@@ -0,0 +1,106 @@
+#include "writer.h"
+
+#include "../bgzf_mt_writer.h"
+#include "../buffered_writer.h"
+#include "../file_writer.h"
+#include "../stream_writer.h"
+#include "../zlib_file_writer.h"
+
+#include <cassert>
+
+namespace ivio {
+
+template <>
+struct writer_base<fastq::writer>::pimpl {
+    using Writers = std::variant<file_writer,
+                                 buffered_writer<zlib_file_writer>,
+                                 stream_writer,
+                                 buffered_writer<zlib_stream_writer>,
+                                 bgzf_mt_file_writer,
+                                 bgzf_mt_stream_writer
+                                 >;
+
+    Writers writer;
+    std::string buffer;
+
+    pimpl(std::filesystem::path output, bool, size_t threadNbr)
+        : writer {[&]() -> Writers {
+            if (output.extension() == ".gz") {
+                if (threadNbr > 0) {
+                    return bgzf_mt_file_writer{output, threadNbr};
+                }
+                return buffered_writer{zlib_file_writer{file_writer{output}}};
+            }
+            return file_writer{output};
+        }()}
+    {}
+
+    pimpl(std::ostream& output, bool compressed, size_t threadNbr)
+        : writer {[&]() -> Writers {
+            if (compressed) {
+                if (threadNbr > 0) {
+                    return bgzf_mt_stream_writer{output, threadNbr};
+                }
+                return buffered_writer{zlib_stream_writer{stream_writer{output}}};
+            }
+            return stream_writer{output};
+        }()}
+    {}
+
+    void append(fastq::record_view const& record) {
+        buffer += '@';
+        buffer += record.id;
+        buffer += '\n';
+        buffer += record.seq;
+        buffer += "\n+";
+        buffer += record.id2;
+        buffer += '\n';
+        buffer += record.qual;
+        buffer += '\n';
+    }
+
+    void flush(bool finish) {
+        std::visit([&](auto& writer) {
+            writer.write(buffer, finish);
+        }, writer);
+        buffer.clear();
+    }
+};
+
+}
+
+namespace ivio::fastq {
+
+writer::writer(config config_)
+    : writer_base{std::visit([&](auto& p) {
+        return std::make_unique<pimpl>(p, config_.compressed, config_.threadNbr);
+    }, config_.output)}
+{}
+
+writer::~writer() {
+    close();
+}
+
+void writer::write(record_view record) {
+    assert(pimpl_);
+    pimpl_->append(record);
+    pimpl_->flush(false);
+}
+
+void writer::write(std::span<record_view const> records) {
+    assert(pimpl_);
+    for (auto const& r : records) {
+        pimpl_->append(r);
+    }
+    pimpl_->flush(false);
+}
+
+void writer::close() {
+    if (!pimpl_) return;
+    pimpl_->flush(true);
+    pimpl_.reset();
+}
+
+static_assert(record_writer_c<writer>);
+
+}
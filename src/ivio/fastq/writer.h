@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../writer_base.h"
+#include "record.h"
+
+#include <filesystem>
+#include <functional>
+#include <ostream>
+#include <span>
+#include <variant>
+
+namespace ivio::fastq {
+
+struct writer : writer_base<writer> {
+    using record_view = fastq::record_view;
+
+    struct config {
+        // Source: file or stream
+        std::variant<std::filesystem::path, std::reference_wrapper<std::ostream>> output;
+
+        // This is only relevant if a stream is being used
+        bool compressed{};
+
+        // Number of compression threads, if set compressed output is written as bgzf
+        size_t threadNbr{0};
+    };
+
+    writer(config config);
+    ~writer();
+
+    void write(record_view record);
+
+    // Writes multiple records with a single call to the underlying writer
+    void write(std::span<record_view const> records);
+    void close();
+};
+
+}
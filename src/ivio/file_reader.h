@@ -8,6 +8,7 @@
 #include <fcntl.h>
 #include <filesystem>
 #include <ranges>
+#include <stdexcept>
 #include <string>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -55,7 +56,18 @@ public:
         }
         return bytes_read;
     }
+
+    auto tell() const -> uint64_t {
+        return ::lseek(fd, 0, SEEK_CUR);
+    }
+
+    void seek(uint64_t pos) {
+        if (::lseek(fd, pos, SEEK_SET) == -1) {
+            throw std::runtime_error{std::string{"seek failed "} + strerror(errno)};
+        }
+    }
 };
 
 static_assert(Readable<file_reader>);
+static_assert(Seekable<file_reader>);
 }
@@ -8,9 +8,20 @@
 #include "zlib_mmap2_reader.h"
 
 #include "fasta/reader.h"
+#include "fasta/writer.h"
+#include "fastq/paired_reader.h"
+#include "fastq/reader.h"
+#include "fastq/writer.h"
+#include "vcf/genotypes.h"
 #include "vcf/reader.h"
 #include "vcf/writer.h"
 #include "bcf/reader.h"
 #include "bcf/writer.h"
+#include "bcf/vcf_transcoder.h"
+#include "bam/reader.h"
+#include "bam/writer.h"
+#include "bam/sam_transcoder.h"
+#include "sam/reader.h"
+#include "sam/writer.h"
 #include "bgzf_reader.h"
 #include "bgzf_writer.h"
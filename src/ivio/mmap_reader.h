@@ -10,14 +10,17 @@ namespace ivio {
 
 class mmap_reader : public file_reader {
 protected:
+    size_t totalSize;
     size_t filesize;
     char const* buffer;
     size_t inPos{};
+    size_t bufferOffset{}; // position of buffer inside the file
 
 public:
     mmap_reader(std::filesystem::path path)
         : file_reader{path}
-        , filesize{file_size(path)}
+        , totalSize{file_size(path)}
+        , filesize{totalSize}
         , buffer{[&]() {
             auto ptr = (char const*)mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, 0);
             return ptr;
@@ -30,9 +33,11 @@ public:
     mmap_reader(mmap_reader const&) = delete;
     mmap_reader(mmap_reader&& _other) noexcept
         : file_reader{std::move(_other)}
+        , totalSize{_other.totalSize}
         , filesize{_other.filesize}
         , buffer{_other.buffer}
         , inPos{_other.inPos}
+        , bufferOffset{_other.bufferOffset}
     {
         assert(buffer);
         _other.buffer = nullptr;
@@ -73,6 +78,7 @@ public:
         munmap((void*)buffer, diff);
         buffer = buffer + diff;
         filesize -= diff;
+        bufferOffset += diff;
         inPos = i - diff;
     }
 
@@ -93,7 +99,30 @@ public:
     auto size() const {
         return filesize;
     }
+
+    auto tell(size_t i) const -> uint64_t {
+        return bufferOffset + inPos + i;
+    }
+
+    void seek(uint64_t pos) {
+        assert(pos <= totalSize);
+        if (pos >= bufferOffset) {
+            inPos = pos - bufferOffset;
+            return;
+        }
+        // memory was already released, map the file again
+        munmap((void*)buffer, filesize);
+        auto mask = std::numeric_limits<size_t>::max() - 4095;
+        bufferOffset = pos & mask;
+        filesize     = totalSize - bufferOffset;
+        buffer       = (char const*)mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, bufferOffset);
+        if (buffer == MAP_FAILED) {
+            throw std::runtime_error{"mmap failed while seeking"};
+        }
+        inPos = pos - bufferOffset;
+    }
 };
 
 static_assert(BufferedReadable<mmap_reader>);
+static_assert(BufferedSeekable<mmap_reader>);
 }
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ivio {
+
+/*!\brief Processes jobs on worker threads, the processed jobs are handed back in the order they were pushed
+ *
+ * Used to parallelize the work on a stream (e.g. compressing blocks, converting batches
+ * of records), while the results are written in order by the calling thread.
+ * Jobs returned by popFront() are recycled by take(), which allows reusing their buffers.
+ */
+template <typename Job>
+struct ordered_job_queue {
+    struct Slot {
+        std::unique_ptr<Job> job;
+        bool                 processing{};
+        bool                 done{};
+        std::exception_ptr   error{};
+    };
+
+    // State shared with the worker threads, stays in place when the queue is moved
+    struct State {
+        std::mutex                        mutex;
+        std::condition_variable           cvWork; // notifies workers about new jobs
+        std::condition_variable           cvDone; // notifies the consuming thread about processed jobs
+        std::deque<Slot>                  pending; // in order of push()
+        std::vector<std::unique_ptr<Job>> unused;
+        bool                              terminate{};
+    };
+
+    std::unique_ptr<State>    state{std::make_unique<State>()};
+    std::vector<std::jthread> threads;
+
+    /*!\param threadNbr   number of worker threads
+     * \param makeProcess called once on each worker thread, returns a callable processing a Job&
+     */
+    template <typename MakeProcess>
+    ordered_job_queue(size_t threadNbr, MakeProcess makeProcess) {
+        for (size_t i{0}; i < threadNbr; ++i) {
+            threads.emplace_back([s = state.get(), makeProcess]() {
+                work(*s, makeProcess());
+            });
+        }
+    }
+
+    ordered_job_queue(ordered_job_queue&&) = default;
+
+    ~ordered_job_queue() {
+        stop();
+    }
+
+    /*!\brief stops and joins the worker threads, pending jobs are not processed anymore
+     */
+    void stop() {
+        if (!state) return;
+        {
+            auto g = std::unique_lock{state->mutex};
+            state->terminate = true;
+        }
+        state->cvWork.notify_all();
+        threads.clear();
+    }
+
+    static void work(State& s, auto&& process) {
+        auto g = std::unique_lock{s.mutex};
+        while (true) {
+            Slot* slot{};
+            s.cvWork.wait(g, [&]() {
+                if (s.terminate) return true;
+                for (auto& p : s.pending) {
+                    if (!p.processing) {
+                        slot = &p;
+                        return true;
+                    }
+                }
+                return false;
+            });
+            if (s.terminate) return;
+            slot->processing = true;
+            g.unlock();
+
+            // references into the deque stay valid while other jobs are pushed
+            auto error = std::exception_ptr{};
+            try {
+                process(*slot->job);
+            } catch(...) {
+                error = std::current_exception();
+            }
+
+            g.lock();
+            slot->error = error;
+            slot->done  = true;
+            s.cvDone.notify_all();
+        }
+    }
+
+    /*!\brief a job to be filled and pushed, recycled from already popped jobs if possible
+     */
+    auto take() -> std::unique_ptr<Job> {
+        auto g = std::unique_lock{state->mutex};
+        if (state->unused.empty()) return std::make_unique<Job>();
+        auto job = std::move(state->unused.back());
+        state->unused.pop_back();
+        return job;
+    }
+
+    void push(std::unique_ptr<Job> job) {
+        {
+            auto g = std::unique_lock{state->mutex};
+            state->pending.emplace_back(Slot{.job = std::move(job)});
+        }
+        state->cvWork.notify_one();
+    }
+
+    // number of pushed jobs which have not been popped yet
+    auto size() const -> size_t {
+        auto g = std::unique_lock{state->mutex};
+        return state->pending.size();
+    }
+
+    // true if the oldest job has been processed and popFront() does not block
+    auto frontDone() const -> bool {
+        auto g = std::unique_lock{state->mutex};
+        return !state->pending.empty() and state->pending.front().done;
+    }
+
+    /*!\brief waits until the oldest job is processed and passes it to consume
+     *
+     * Rethrows the exception if processing the job failed.
+     */
+    void popFront(auto&& consume) {
+        auto& s = *state;
+        auto g = std::unique_lock{s.mutex};
+        s.cvDone.wait(g, [&]() { return s.pending.front().done; });
+        auto slot = std::move(s.pending.front());
+        s.pending.pop_front();
+        g.unlock();
+
+        if (slot.error) std::rethrow_exception(slot.error);
+        consume(*slot.job);
+
+        g.lock();
+        s.unused.emplace_back(std::move(slot.job));
+    }
+};
+
+}
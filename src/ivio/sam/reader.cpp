@@ -33,7 +33,7 @@ struct reader_base<sam::reader>::pimpl {
     VarBufferedReader ureader;
     size_t lastUsed{};
 
-    std::vector<std::string> header;
+    std::string header;
 
     pimpl(std::filesystem::path file)
         : ureader {[&]() -> VarBufferedReader {
@@ -51,6 +51,7 @@ struct reader_base<sam::reader>::pimpl {
         if (size >= 1 and buffer[0] == '@') {
             auto end = ureader.readUntil('\n', 0);
             if (ureader.eof(end)) return false;
+            header += ureader.string_view(0, end+1);
             ureader.dropUntil(end+1);
             return true;
         }
@@ -89,6 +90,7 @@ reader::reader(config const& config_)
     }, config_.input)}
 {
     pimpl_->readHeader();
+    header_ = std::move(pimpl_->header);
 }
 
 
@@ -108,6 +110,13 @@ auto reader::next() -> std::optional<record_view> {
 
     auto [qname, flag, rname, pos, mapq, cigar, rnext, pnext, tlen, seq, qual] = *res;
 
+    // the last column also contains the optional fields
+    auto tags = std::string_view{};
+    if (auto p = qual.find('\t'); p != std::string_view::npos) {
+        tags = qual.substr(p+1);
+        qual = qual.substr(0, p);
+    }
+
     return record_view {.qname = qname,
                         .flag  = convertTo<int32_t>(flag),
                         .rname = rname,
@@ -119,6 +128,7 @@ auto reader::next() -> std::optional<record_view> {
                         .tlen  = convertTo<int32_t>(tlen),
                         .seq   = seq,
                         .qual  = qual,
+                        .tags  = tags,
                       };
 }
 
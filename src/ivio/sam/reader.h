@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <optional>
+#include <string>
 #include <tuple>
 #include <variant>
 #include <vector>
@@ -15,6 +16,8 @@ struct reader : public reader_base<reader> {
     using record      = sam::record;
     using record_view = sam::record_view;
 
+    std::string header_; // all header lines, including their line breaks
+
     struct config {
         // Source: file or stream
         std::variant<std::filesystem::path, std::reference_wrapper<std::istream>> input;
@@ -26,6 +29,7 @@ public:
 
     bool readHeaderLine();
     void readHeader();
+    auto header() const -> std::string const& { return header_; }
     auto next() -> std::optional<record_view>;
     void close();
 };
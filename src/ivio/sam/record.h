@@ -1,6 +1,10 @@
 #pragma once
 
+#include "tags.h"
+
 #include <cstddef>
+#include <optional>
+#include <string>
 #include <string_view>
 
 namespace ivio::sam {
@@ -17,6 +21,17 @@ struct record_view {
     int32_t                     tlen;
     std::string_view            seq;
     std::string_view            qual;
+    std::string_view            tags; // optional fields, tab separated
+
+    // Lazy iteration over the optional fields
+    auto tagRange() const -> tag_range {
+        return {tags};
+    }
+
+    // Searches for a single tag, e.g. findTag("NM")
+    auto findTag(std::string_view key) const -> std::optional<tag> {
+        return tag_range{tags}.find(key);
+    }
 };
 
 struct record {
@@ -31,6 +46,7 @@ struct record {
     int32_t                tlen;
     std::string            seq;
     std::string            qual;
+    std::string            tags;
 
     record() = default;
     record(record_view v)
@@ -45,6 +61,7 @@ struct record {
         , tlen {v.tlen}
         , seq  {v.seq}
         , qual {v.qual}
+        , tags {v.tags}
     {}
     operator record_view() const {
         return record_view {
@@ -58,7 +75,8 @@ struct record {
             pnext,
             tlen,
             seq,
-            qual
+            qual,
+            tags,
         };
     }
 };
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace ivio::sam {
+
+/*!\brief A single optional field (TAG:TYPE:VALUE) of a sam record, pointing into the line
+ *
+ * type is one of A, i, f, Z, H or B. For B the value starts with the subtype,
+ * e.g. "c,1,2,3".
+ */
+struct tag {
+    std::string_view key;
+    char             type;
+    std::string_view value;
+
+    auto asInt() const -> std::optional<int64_t> {
+        if (type != 'i') return std::nullopt;
+        int64_t v{};
+        auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), v);
+        if (ec != std::errc{}) return std::nullopt;
+        return v;
+    }
+
+    auto asFloat() const -> std::optional<float> {
+        if (type != 'f') return std::nullopt;
+        float v{};
+        auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), v);
+        if (ec != std::errc{}) return std::nullopt;
+        return v;
+    }
+
+    auto asChar() const -> std::optional<char> {
+        if (type != 'A' or value.size() != 1) return std::nullopt;
+        return value[0];
+    }
+
+    /*!\brief value of string tags (Z, H)
+     */
+    auto asString() const -> std::optional<std::string_view> {
+        if (type != 'Z' and type != 'H') return std::nullopt;
+        return value;
+    }
+
+    /*!\brief subtype of an array tag (B)
+     */
+    auto arrayType() const -> char {
+        if (type != 'B' or value.empty()) return '\0';
+        return value[0];
+    }
+
+    /*!\brief comma separated elements of an array tag (B)
+     */
+    auto arrayData() const -> std::string_view {
+        if (type != 'B' or value.size() < 2) return {};
+        return value.substr(2);
+    }
+};
+
+/*!\brief Lazy range over the tab separated optional fields of a sam record
+ *
+ * Tags are decoded while iterating, no memory is allocated.
+ */
+struct tag_range {
+    std::string_view data;
+
+    /*!\brief decodes the field starting at data[pos]
+     * \returns the tag and the position of the next field
+     */
+    static auto decode(std::string_view data, size_t pos) -> std::tuple<tag, size_t> {
+        auto end = data.find('\t', pos);
+        if (end == std::string_view::npos) end = data.size();
+        auto field = data.substr(pos, end - pos);
+        if (field.size() < 5 or field[2] != ':' or field[4] != ':') {
+            throw std::runtime_error{"SAM error: malformed optional field " + std::string{field}};
+        }
+        auto next = (end == data.size()) ? end : end+1;
+        return {tag{field.substr(0, 2), field[3], field.substr(5)}, next};
+    }
+
+    struct iter {
+        using value_type      = tag;
+        using difference_type = std::ptrdiff_t;
+
+        std::string_view data{};
+        size_t           pos{};
+
+        auto operator*() const -> tag {
+            return std::get<0>(decode(data, pos));
+        }
+        auto operator++() -> iter& {
+            pos = std::get<1>(decode(data, pos));
+            return *this;
+        }
+        auto operator++(int) -> iter {
+            auto r = *this;
+            ++*this;
+            return r;
+        }
+        auto operator==(iter const& _other) const -> bool {
+            return pos == _other.pos;
+        }
+    };
+
+    auto begin() const -> iter {
+        return {data, 0};
+    }
+    auto end() const -> iter {
+        return {data, data.size()};
+    }
+
+    /*!\brief searches for a tag by its two character key, e.g. find("NM")
+     */
+    auto find(std::string_view key) const -> std::optional<tag> {
+        if (key.size() != 2) return std::nullopt;
+        size_t pos{0};
+        while (pos < data.size()) {
+            // only fields with a matching key are decoded
+            if (data.substr(pos, 2) == key) {
+                return std::get<0>(decode(data, pos));
+            }
+            pos = data.find('\t', pos);
+            if (pos == std::string_view::npos) break;
+            pos += 1;
+        }
+        return std::nullopt;
+    }
+};
+
+}
@@ -0,0 +1,132 @@
+#include "writer.h"
+
+#include "../bgzf_mt_writer.h"
+#include "../buffered_writer.h"
+#include "../file_writer.h"
+#include "../stream_writer.h"
+#include "../zlib_file_writer.h"
+
+#include <cassert>
+#include <charconv>
+
+namespace {
+void appendInt(std::string& buffer, int32_t v) {
+    auto oldSize = buffer.size();
+    buffer.resize(oldSize + 11); // enough for any int32_t
+    auto [ptr, ec] = std::to_chars(buffer.data() + oldSize, buffer.data() + buffer.size(), v);
+    buffer.resize(ptr - buffer.data());
+}
+
+// missing string fields are written as '*'
+void appendField(std::string& buffer, std::string_view v) {
+    if (v.empty()) buffer += '*';
+    else           buffer += v;
+}
+}
+
+template <>
+struct ivio::writer_base<ivio::sam::writer>::pimpl {
+    using Writers = std::variant<file_writer,
+                                 buffered_writer<zlib_file_writer>,
+                                 stream_writer,
+                                 buffered_writer<zlib_stream_writer>,
+                                 bgzf_mt_file_writer,
+                                 bgzf_mt_stream_writer
+                                 >;
+
+    Writers writer;
+    std::string buffer;
+
+    pimpl(std::filesystem::path output, bool, size_t threadNbr)
+        : writer {[&]() -> Writers {
+            if (output.extension() == ".gz") {
+                if (threadNbr > 0) {
+                    return bgzf_mt_file_writer{output, threadNbr};
+                }
+                return buffered_writer{zlib_file_writer{file_writer{output}}};
+            }
+            return file_writer{output};
+        }()}
+    {}
+
+    pimpl(std::ostream& output, bool compressed, size_t threadNbr)
+        : writer {[&]() -> Writers {
+            if (compressed) {
+                if (threadNbr > 0) {
+                    return bgzf_mt_stream_writer{output, threadNbr};
+                }
+                return buffered_writer{zlib_stream_writer{stream_writer{output}}};
+            }
+            return stream_writer{output};
+        }()}
+    {}
+
+    void append(sam::record_view const& r) {
+        appendField(buffer, r.qname); buffer += '\t';
+        appendInt(buffer, r.flag);    buffer += '\t';
+        appendField(buffer, r.rname); buffer += '\t';
+        appendInt(buffer, r.pos);     buffer += '\t';
+        appendInt(buffer, r.mapq);    buffer += '\t';
+        appendField(buffer, r.cigar); buffer += '\t';
+        appendField(buffer, r.rnext); buffer += '\t';
+        appendInt(buffer, r.pnext);   buffer += '\t';
+        appendInt(buffer, r.tlen);    buffer += '\t';
+        appendField(buffer, r.seq);   buffer += '\t';
+        appendField(buffer, r.qual);
+        if (!r.tags.empty()) {
+            buffer += '\t';
+            buffer += r.tags;
+        }
+        buffer += '\n';
+    }
+
+    void flush(bool finish) {
+        std::visit([&](auto& writer) {
+            writer.write(buffer, finish);
+        }, writer);
+        buffer.clear();
+    }
+};
+
+namespace ivio::sam {
+
+writer::writer(config config_)
+    : writer_base{std::visit([&](auto& p) {
+        return std::make_unique<pimpl>(p, config_.compressed, config_.threadNbr);
+    }, config_.output)}
+{
+    auto& buffer = pimpl_->buffer;
+    buffer = config_.header;
+    if (!buffer.empty() and buffer.back() != '\n') {
+        buffer += '\n';
+    }
+    pimpl_->flush(false);
+}
+
+writer::~writer() {
+    close();
+}
+
+void writer::write(record_view record) {
+    assert(pimpl_);
+    pimpl_->append(record);
+    pimpl_->flush(false);
+}
+
+void writer::write(std::span<record_view const> records) {
+    assert(pimpl_);
+    for (auto const& r : records) {
+        pimpl_->append(r);
+    }
+    pimpl_->flush(false);
+}
+
+void writer::close() {
+    if (!pimpl_) return;
+    pimpl_->flush(true);
+    pimpl_.reset();
+}
+
+static_assert(record_writer_c<writer>);
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "bgzf_index.h"
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace ivio {
+
+/*!\brief reads each shard of an indexed file with its own reader in its own thread
+ *
+ * \param config configuration of the reader, the input must be a seekable file
+ * \param shards ranges of records, as returned by bgzf_index::shards
+ * \param cb     callback, called as `cb(shardIdx, record_view)` from the thread of the shard
+ *
+ * Records of a single shard are reported in file order, different shards run concurrently.
+ * Exceptions thrown inside a shard are rethrown after all threads finished.
+ */
+template <typename Reader, typename CB>
+void for_each_shard(typename Reader::config const& config, std::vector<bgzf_index::shard> const& shards, CB&& cb) {
+    auto errors = std::vector<std::exception_ptr>(shards.size());
+    {
+        auto threads = std::vector<std::jthread>{};
+        for (size_t i{0}; i < shards.size(); ++i) {
+            threads.emplace_back([&, i]() {
+                try {
+                    auto reader = Reader{config};
+                    reader.seek(shards[i].begin);
+                    while (reader.tell() < shards[i].end) {
+                        auto record = reader.next();
+                        if (!record) break;
+                        cb(i, *record);
+                    }
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+    }
+    for (auto const& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+}
@@ -4,12 +4,14 @@
 
 #include <istream>
 #include <ranges>
+#include <stdexcept>
 
 namespace ivio {
 
 class stream_reader {
 protected:
     std::istream& stream;
+    uint64_t      pos{}; // counted, since tellg() isn't available for pipes
 public:
     stream_reader(std::istream& _stream)
         : stream{_stream}
@@ -23,11 +25,24 @@ public:
     auto operator=(stream_reader const&) -> stream_reader& = delete;
     auto operator=(stream_reader&&) -> stream_reader& = delete;
 
-    size_t read(std::ranges::sized_range auto&& range) const {
+    size_t read(std::ranges::sized_range auto&& range) {
         stream.read(&*std::ranges::begin(range), std::ranges::size(range));
+        pos += stream.gcount();
         return stream.gcount();
     }
+
+    auto tell() const -> uint64_t {
+        return pos;
+    }
+
+    void seek(uint64_t _pos) {
+        stream.clear();
+        stream.seekg(_pos);
+        if (!stream) throw std::runtime_error{"stream doesn't support seeking"};
+        pos = _pos;
+    }
 };
 
 static_assert(Readable<stream_reader>);
+static_assert(Seekable<stream_reader>);
 }
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ivio {
+
+/*!\brief Dense table of names with O(1) lookups in both directions
+ *
+ * All names are stored consecutively in a single arena. The hash table only holds
+ * ids, which keeps the dictionary cheap to copy and move.
+ */
+struct string_dictionary {
+private:
+    struct entry {
+        size_t offset;
+        size_t length;
+        size_t hash;
+    };
+
+    std::string          arena;
+    std::vector<entry>   entries;
+    std::vector<int32_t> slots; // open addressing, -1 marks an empty slot
+
+    void rehash(size_t slotNbr) {
+        slots.assign(slotNbr, -1);
+        for (size_t id{0}; id < entries.size(); ++id) {
+            auto i = entries[id].hash & (slots.size()-1);
+            while (slots[i] != -1) {
+                i = (i+1) & (slots.size()-1);
+            }
+            slots[i] = id;
+        }
+    }
+
+public:
+    void reserve(size_t n, size_t nameBytes = 0) {
+        entries.reserve(n);
+        arena.reserve(nameBytes);
+        if (slots.size() < n*2) {
+            rehash(std::bit_ceil(n*2));
+        }
+    }
+
+    /*!\brief appends a name
+     * \returns the id of the name, which is its position in the table
+     */
+    auto push(std::string_view name) -> size_t {
+        if (slots.size() < (entries.size()+1)*2) {
+            rehash(std::max(size_t{16}, slots.size()*2));
+        }
+        auto h = std::hash<std::string_view>{}(name);
+        entries.push_back({arena.size(), name.size(), h});
+        arena += name;
+
+        auto id = entries.size()-1;
+        auto i = h & (slots.size()-1);
+        while (slots[i] != -1) {
+            i = (i+1) & (slots.size()-1);
+        }
+        slots[i] = id;
+        return id;
+    }
+
+    auto size() const -> size_t {
+        return entries.size();
+    }
+
+    auto operator[](size_t id) const -> std::string_view {
+        auto const& e = entries[id];
+        return std::string_view{arena}.substr(e.offset, e.length);
+    }
+
+    /*!\brief looks up the id of a name
+     * \returns the id of the first entry with this name or std::nullopt
+     */
+    auto find(std::string_view name) const -> std::optional<size_t> {
+        if (slots.empty()) return std::nullopt;
+        auto h = std::hash<std::string_view>{}(name);
+        auto i = h & (slots.size()-1);
+        while (slots[i] != -1) {
+            auto id = size_t(slots[i]);
+            if (entries[id].hash == h and (*this)[id] == name) {
+                return id; // earlier entries are always found first
+            }
+            i = (i+1) & (slots.size()-1);
+        }
+        return std::nullopt;
+    }
+};
+
+}
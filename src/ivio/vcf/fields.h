@@ -0,0 +1,137 @@
+#pragma once
+
+#include "header.h"
+
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace ivio::vcf {
+
+/*!\brief Value of a single INFO or FORMAT field, pointing into the record
+ *
+ * Values with multiple elements are comma separated, missing values are '.'.
+ */
+struct field_value {
+    std::string_view        key;
+    std::string_view        value;        // empty for flags
+    field_definition const* definition{}; // nullptr if the key is not declared in the header
+
+    auto isFlag() const -> bool {
+        return value.empty() or (definition and definition->type == "Flag");
+    }
+
+    // number of comma separated elements
+    auto size() const -> size_t {
+        if (value.empty()) return 0;
+        return std::ranges::count(value, ',') + 1;
+    }
+
+    auto at(size_t i) const -> std::string_view {
+        auto v = value;
+        for (; i > 0; --i) {
+            auto p = v.find(',');
+            if (p == std::string_view::npos) return {};
+            v.remove_prefix(p+1);
+        }
+        return v.substr(0, v.find(','));
+    }
+
+    /*!\brief i-th element as integer
+     * \returns std::nullopt if missing, not a number or declared with a different type
+     */
+    auto asInt(size_t i = 0) const -> std::optional<int64_t> {
+        if (definition and definition->type != "Integer") return std::nullopt;
+        return convert<int64_t>(at(i));
+    }
+
+    /*!\brief i-th element as float, also accepts fields declared as Integer
+     */
+    auto asFloat(size_t i = 0) const -> std::optional<float> {
+        if (definition and definition->type != "Float" and definition->type != "Integer") return std::nullopt;
+        return convert<float>(at(i));
+    }
+
+    auto asString() const -> std::string_view {
+        return value;
+    }
+
+private:
+    template <typename T>
+    static auto convert(std::string_view v) -> std::optional<T> {
+        if (v.empty() or v == ".") return std::nullopt;
+        T result{};
+        auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), result);
+        if (ec != std::errc{} or ptr != v.data() + v.size()) return std::nullopt;
+        return result;
+    }
+};
+
+/*!\brief Searches key in the INFO column, without creating an index
+ */
+inline auto findInfo(std::string_view infos, std::string_view key) -> std::optional<std::tuple<std::string_view, std::string_view>> {
+    if (infos == ".") return std::nullopt;
+    while (!infos.empty()) {
+        auto end   = infos.find(';');
+        auto entry = infos.substr(0, end);
+        auto eq    = entry.find('=');
+        if (entry.substr(0, eq) == key) {
+            if (eq == std::string_view::npos) return std::tuple{entry, std::string_view{}};
+            return std::tuple{entry.substr(0, eq), entry.substr(eq+1)};
+        }
+        if (end == std::string_view::npos) break;
+        infos.remove_prefix(end+1);
+    }
+    return std::nullopt;
+}
+
+/*!\brief Positions of all keys of the INFO column of the current record
+ *
+ * Owned by the reader, see vcf::reader::info(). The index is only built when a field
+ * is requested and reused for all further requests on the same record.
+ */
+struct info_index {
+    std::string_view infos;
+    bool             indexed{};
+
+    std::vector<std::tuple<std::string_view, std::string_view>> entries; // key and value
+
+    void reset(std::string_view infos_) {
+        infos   = infos_;
+        indexed = false;
+    }
+
+    void build() {
+        entries.clear();
+        indexed = true;
+        if (infos == ".") return;
+        auto v = infos;
+        while (!v.empty()) {
+            auto end   = v.find(';');
+            auto entry = v.substr(0, end);
+            auto eq    = entry.find('=');
+            if (eq == std::string_view::npos) {
+                entries.emplace_back(entry, std::string_view{});
+            } else {
+                entries.emplace_back(entry.substr(0, eq), entry.substr(eq+1));
+            }
+            if (end == std::string_view::npos) break;
+            v.remove_prefix(end+1);
+        }
+    }
+
+    auto find(std::string_view key, vcf::header const* header = nullptr) -> std::optional<field_value> {
+        if (!indexed) build();
+        for (auto const& [k, v] : entries) {
+            if (k == key) {
+                return field_value{k, v, header ? header->info(k) : nullptr};
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "record.h"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace ivio::vcf {
+
+constexpr int8_t genotype_missing    = -1; // allele is '.'
+constexpr int8_t genotype_vector_end = -2; // sample has fewer alleles than the requested ploidy
+
+/*!\brief Extracts the GT field of all samples of a record
+ *
+ * \param out    allele k of sample s is written to out[s * stride + k]
+ * \param ploidy number of alleles written per sample, missing alleles are filled with genotype_vector_end
+ * \param stride distance between two samples in out, 0 selects ploidy. Passing the number of
+ *               records times ploidy (and an offset of record index times ploidy) creates a
+ *               sample major matrix over multiple records
+ * \param phased optional, phased[s] is set to 1 if all alleles of sample s are phased ('|'),
+ *               including an optional leading marker of the first allele (VCF 4.4)
+ * \returns number of samples
+ *
+ * Only GT is parsed, the other FORMAT fields of each sample are skipped with memchr.
+ */
+inline auto extractGenotypes(record_view const& r, std::span<int8_t> out, size_t ploidy = 2, size_t stride = 0, std::span<uint8_t> phased = {}) -> size_t {
+    if (stride == 0) stride = ploidy;
+
+    // position of GT inside the FORMAT column, by specification it should be the first one
+    size_t gtIdx{};
+    {
+        auto f = r.formats;
+        while (true) {
+            auto end = f.find(':');
+            if (f.substr(0, end) == "GT") break;
+            if (end == std::string_view::npos) return 0;
+            f.remove_prefix(end+1);
+            ++gtIdx;
+        }
+    }
+
+    if (r.samples.empty()) return 0;
+    auto ptr = r.samples.data();
+    auto end = ptr + r.samples.size();
+    size_t sample{};
+    while (true) {
+        auto sampleEnd = static_cast<char const*>(std::memchr(ptr, '\t', end - ptr));
+        if (sampleEnd == nullptr) sampleEnd = end;
+
+        auto base = sample * stride;
+        if (base + ploidy > out.size()) throw std::runtime_error{"VCF error: genotype buffer is too small"};
+
+        // skip fields in front of GT
+        auto gt = ptr;
+        for (size_t i{0}; i < gtIdx and gt < sampleEnd; ++i) {
+            auto next = static_cast<char const*>(std::memchr(gt, ':', sampleEnd - gt));
+            gt = next ? next + 1 : sampleEnd;
+        }
+
+        size_t k{};
+        bool isPhased{true};
+
+        // VCF 4.4 allows a leading phasing marker for the first allele, e.g. |0|1
+        if (gt < sampleEnd and (*gt == '|' or *gt == '/')) {
+            isPhased = *gt == '|';
+            ++gt;
+        }
+        while (gt < sampleEnd and *gt != ':') {
+            auto allele = genotype_missing;
+            if (*gt == '.') {
+                ++gt;
+            } else {
+                int v{};
+                auto start = gt;
+                while (gt < sampleEnd and *gt >= '0' and *gt <= '9' and v <= 127) {
+                    v = v * 10 + (*gt - '0');
+                    ++gt;
+                }
+                if (gt == start or v > 127) {
+                    throw std::runtime_error{"VCF error: invalid genotype " + std::string{ptr, sampleEnd}};
+                }
+                allele = int8_t(v);
+            }
+            if (k < ploidy) out[base + k] = allele;
+            ++k;
+            if (gt < sampleEnd and (*gt == '|' or *gt == '/')) {
+                isPhased = isPhased and *gt == '|';
+                ++gt;
+            }
+        }
+        for (; k < ploidy; ++k) {
+            out[base + k] = genotype_vector_end;
+        }
+        if (!phased.empty()) {
+            if (sample >= phased.size()) throw std::runtime_error{"VCF error: phasing buffer is too small"};
+            phased[sample] = isPhased;
+        }
+
+        ++sample;
+        if (sampleEnd == end) break;
+        ptr = sampleEnd + 1;
+    }
+    return sample;
+}
+
+}
@@ -1,13 +1,124 @@
 #pragma once
 
-#include <vector>
+#include "../string_dictionary.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
 namespace ivio::vcf {
 
+/*!\brief Definition of an INFO or FORMAT field, e.g. ##INFO=<ID=AF,Number=A,Type=Float,Description="...">
+ */
+struct field_definition {
+    std::string id;
+    std::string number; // a number, A, R, G or .
+    std::string type;   // Integer, Float, Flag, Character or String
+    std::string description;
+
+    std::optional<int32_t> idx; // explicit dictionary index (IDX=), as written by bcf tools
+
+    /*!\brief calls cb(key, value) for every attribute of a structured header line,
+     * e.g. <ID=AF,Number=A,Description="..."> (including the angle brackets)
+     */
+    template <typename CB>
+    static void forEachAttribute(std::string_view value, CB&& cb) {
+        if (value.starts_with('<')) value.remove_prefix(1);
+        if (value.ends_with('>')) value.remove_suffix(1);
+        while (!value.empty()) {
+            auto eq = value.find('=');
+            if (eq == std::string_view::npos) break;
+            auto key = value.substr(0, eq);
+            value.remove_prefix(eq+1);
+
+            // values may be quoted and contain commas
+            auto entry = std::string_view{};
+            if (value.starts_with('"')) {
+                auto end = value.find('"', 1);
+                while (end != std::string_view::npos and value[end-1] == '\\') {
+                    end = value.find('"', end+1);
+                }
+                if (end == std::string_view::npos) end = value.size();
+                entry = value.substr(1, end-1);
+                value.remove_prefix(std::min(end+1, value.size()));
+            } else {
+                entry = value.substr(0, value.find(','));
+                value.remove_prefix(entry.size());
+            }
+            if (value.starts_with(',')) value.remove_prefix(1);
+            cb(key, entry);
+        }
+    }
+
+    static auto parseIdx(std::string_view entry) -> int32_t {
+        int32_t v{};
+        auto [ptr, ec] = std::from_chars(entry.data(), entry.data() + entry.size(), v);
+        if (ec != std::errc{} or ptr != entry.data() + entry.size() or v < 0) {
+            throw std::runtime_error{"VCF error: invalid IDX " + std::string{entry}};
+        }
+        return v;
+    }
+
+    /*!\brief parses the value of a ##INFO, ##FORMAT or ##FILTER line (including the angle brackets)
+     */
+    static auto parse(std::string_view value) -> field_definition {
+        auto def = field_definition{};
+        forEachAttribute(value, [&](std::string_view key, std::string_view entry) {
+            if      (key == "ID")          def.id          = entry;
+            else if (key == "Number")      def.number      = entry;
+            else if (key == "Type")        def.type        = entry;
+            else if (key == "Description") def.description = entry;
+            else if (key == "IDX")         def.idx         = parseIdx(entry);
+        });
+        return def;
+    }
+};
+
 struct header {
     std::vector<std::tuple<std::string, std::string>> table;
     std::vector<std::string> genotypes;
+
+    // ##INFO and ##FORMAT definitions, filled by readDefinitions()
+    std::vector<field_definition> infos;
+    std::vector<field_definition> formats;
+    string_dictionary             infoIds;
+    string_dictionary             formatIds;
+
+    /*!\brief parses all ##INFO and ##FORMAT lines of table
+     */
+    void readDefinitions() {
+        infos.clear();
+        formats.clear();
+        infoIds   = {};
+        formatIds = {};
+        for (auto const& [key, value] : table) {
+            if (key == "INFO") {
+                infos.push_back(field_definition::parse(value));
+                infoIds.push(infos.back().id);
+            } else if (key == "FORMAT") {
+                formats.push_back(field_definition::parse(value));
+                formatIds.push(formats.back().id);
+            }
+        }
+    }
+
+    auto info(std::string_view id) const -> field_definition const* {
+        auto i = infoIds.find(id);
+        if (!i) return nullptr;
+        return &infos[*i];
+    }
+
+    auto format(std::string_view id) const -> field_definition const* {
+        auto i = formatIds.find(id);
+        if (!i) return nullptr;
+        return &formats[*i];
+    }
 };
 
 }
@@ -36,6 +36,8 @@ struct reader_base<vcf::reader>::pimpl {
     std::vector<std::tuple<std::string, std::string>> header;
     std::vector<std::string> genotypes;
 
+    vcf::info_index infoIndex;
+
     pimpl(std::filesystem::path file, bool)
         : ureader {[&]() -> VarBufferedReader {
             if (file.extension() == ".vcf") {
@@ -120,6 +122,7 @@ reader::reader(config const& config_)
     pimpl_->readHeader();
     header_.table     = std::move(pimpl_->header);
     header_.genotypes = std::move(pimpl_->genotypes);
+    header_.readDefinitions();
 }
 
 
@@ -139,13 +142,15 @@ auto reader::next() -> std::optional<record_view> {
 
     auto [chrom, pos, id, ref, alts, qual, filters, infos, formats, samples] = *res;
 
+    pimpl_->infoIndex.reset(infos);
+
     return record_view {
         .chrom   = chrom,
         .pos     = convertTo<int32_t>(pos),
         .id      = id,
         .ref     = ref,
         .alts    = alts,
-        .qual    = convertTo<float>(qual),
+        .qual    = (qual == ".") ? std::nullopt : std::optional{convertTo<float>(qual)},
         .filters = filters,
         .infos   = infos,
         .formats = formats,
@@ -153,6 +158,17 @@ auto reader::next() -> std::optional<record_view> {
     };
 }
 
+auto reader::info(record_view const& record, std::string_view key) -> std::optional<field_value> {
+    assert(pimpl_);
+
+    // the index only belongs to the record returned by the last call to next()
+    auto& index = pimpl_->infoIndex;
+    if (index.infos.data() != record.infos.data() or index.infos.size() != record.infos.size()) {
+        return record.info(key, &header_);
+    }
+    return index.find(key, &header_);
+}
+
 void reader::close() {
     pimpl_.reset();
 }
@@ -6,6 +6,7 @@
 
 #include <filesystem>
 #include <optional>
+#include <string_view>
 #include <tuple>
 #include <variant>
 #include <vector>
@@ -32,6 +33,13 @@ public:
 
     auto header() const -> vcf::header const& { return header_; }
     auto next() -> std::optional<record_view>;
+
+    /*!\brief looks up an INFO field of record, typed via the ##INFO definitions of the header
+     *
+     * For the record returned by the last call to next() the positions of all keys are
+     * cached, repeated lookups do not scan the INFO column again. Other records are scanned.
+     */
+    auto info(record_view const& record, std::string_view key) -> std::optional<field_value>;
     void close();
 };
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "fields.h"
+
 #include <cstddef>
 #include <optional>
 #include <span>
@@ -19,6 +21,47 @@ struct record_view {
     std::string_view            infos;
     std::string_view            formats;
     std::string_view            samples;
+
+    /*!\brief looks up an INFO field, e.g. info("AF")
+     *
+     * Scans the INFO column on every call, vcf::reader::info() caches the positions of
+     * the keys for repeated lookups. Typed via the ##INFO definitions of header, if given.
+     */
+    auto info(std::string_view key, vcf::header const* header = nullptr) const -> std::optional<field_value> {
+        auto r = findInfo(infos, key);
+        if (!r) return std::nullopt;
+        auto [k, v] = *r;
+        return field_value{k, v, header ? header->info(k) : nullptr};
+    }
+
+    /*!\brief looks up a FORMAT field of a single sample, e.g. format("DP", 0)
+     */
+    auto format(std::string_view key, size_t sample, vcf::header const* header = nullptr) const -> std::optional<field_value> {
+        // position of key inside the FORMAT column
+        size_t idx{};
+        auto f = formats;
+        while (true) {
+            auto end = f.find(':');
+            if (f.substr(0, end) == key) break;
+            if (end == std::string_view::npos) return std::nullopt;
+            f.remove_prefix(end+1);
+            ++idx;
+        }
+
+        auto column = [](std::string_view v, char sep, size_t i) -> std::optional<std::string_view> {
+            for (; i > 0; --i) {
+                auto p = v.find(sep);
+                if (p == std::string_view::npos) return std::nullopt;
+                v.remove_prefix(p+1);
+            }
+            return v.substr(0, v.find(sep));
+        };
+        auto s = column(samples, '\t', sample);
+        if (!s) return std::nullopt;
+        auto value = column(*s, ':', idx);
+        if (!value) return std::nullopt; // trailing fields may be omitted
+        return field_value{key, *value, header ? header->format(key) : nullptr};
+    }
 };
 
 struct record {
@@ -105,7 +105,7 @@ void writer::write(record_view record) {
             ss += str.str();
         }
     } else {
-        ss += '*';
+        ss += '.';
     }
     ss += '\t';
 
@@ -11,6 +11,8 @@
 namespace ivio::vcf {
 
 struct writer : writer_base<writer> {
+    using record_view = vcf::record_view;
+
     struct config {
         // Source: file or stream
         std::variant<std::filesystem::path, std::reference_wrapper<std::ostream>> output;
@@ -7,6 +7,8 @@
 
 #include <zlib.h>
 #include <ranges>
+#include <stdexcept>
+#include <string>
 
 namespace ivio {
 
@@ -21,6 +23,7 @@ struct zlib_reader {
         .zfree = Z_NULL,
         .opaque = Z_NULL,
     };
+    bool finished{}; // end of the last gzip member was reached
 
     zlib_reader(VarBufferedReader reader)
         : reader{std::move(reader)}
@@ -42,7 +45,7 @@ struct zlib_reader {
     }
 
     size_t read(std::ranges::sized_range auto&& range) {
-        while(true) {
+        while(!finished) {
             auto [ptr, avail_in] = reader.read(range.size());
 
             stream.next_in  = (unsigned char*)(ptr);
@@ -54,14 +57,30 @@ struct zlib_reader {
 
             reader.dropUntil(diff);
 
+            if (ret == Z_STREAM_END) {
+                // continue with the next member of concatenated gzip files (e.g. bgzf),
+                // trailing data that is not a gzip member (e.g. padding) is ignored
+                auto [next, avail] = reader.read(2);
+                if (avail >= 2 and uint8_t(next[0]) == 0x1f and uint8_t(next[1]) == 0x8b) {
+                    inflateReset(&stream);
+                } else {
+                    finished = true;
+                }
+            } else if (ret != Z_OK and ret != Z_BUF_ERROR) {
+                throw std::runtime_error{"zlib error: failed to inflate (" + std::to_string(ret) + ")"};
+            }
+
             auto producedBytes = (size_t)(stream.next_out - (unsigned char*)&*std::begin(range));
             if (producedBytes > 0) {
                 return producedBytes;
             }
-            if (ret == Z_STREAM_END) {
-                return 0;
+            if (avail_in == 0) {
+                if (std::get<1>(reader.read(1)) == 0) {
+                    return 0;
+                }
             }
         }
+        return 0;
     }
 };
 